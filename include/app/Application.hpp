@@ -3,6 +3,8 @@
 #include <span>
 
 #include "ArgumentsParser.hpp"
+#include "core/Image.hpp"
+#include "core/Renderer.hpp"
 
 namespace nfract
 {
@@ -16,6 +18,12 @@ namespace nfract
         int execute() const;
 
     private:
+        /// Renders through the field kernels, for --state-out and --resume
+        int execute_resumable(Renderer& renderer, const Arguments& arguments) const;
+
+        /// Encodes the finished image once, to the --out path
+        int save(const Image& img) const;
+
         Arguments m_arguments;
     };
 }
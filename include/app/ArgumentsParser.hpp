@@ -1,31 +1,27 @@
 #pragma once
 
 #include <span>
-#include <stdexcept>
 #include <string>
+#include <vector>
+
+#include "core/Atlas.hpp"
+#include "core/RenderParams.hpp"
 
 namespace nfract
 {
-    enum class ColorMode
-    {
-        JEWELRY = 0,
-        NEON = 1,
-        CLASSIC = 2,
-    };
-
-    struct Arguments
+    /// Render parameters plus what only the command line needs
+    struct Arguments : RenderParams
     {
-        int degree = 5; // n in z^n - 1 = 0
-        int width = 1920;
-        int height = 1080;
-        int maxIter = 100;
-        float xmin = -2.0f;
-        float xmax = 2.0f;
-        float ymin = -2.0f;
-        float ymax = 2.0f;
-        float tolerance = 1e-3f;
         std::string outputPath = "nfract.png";
-        ColorMode colorMode = ColorMode::CLASSIC;
+        // Atlas mode: cells laid out row-major, atlasColumns per row, each width x height pixels; empty renders one image
+        std::vector<AtlasCell> atlas;
+        int atlasColumns = 0;
+        bool maxIterAuto = false; // --max-iter auto: maxIter is chosen from a probe (see core/IterationBudget.hpp)
+        double maxIterCoverage = 0.999; // share of converging pixels the chosen maxIter must cover
+        int deadlineMs = 0; // 0: no deadline, otherwise degrade quality to finish within it (see core/Deadline.hpp)
+        // Iteration state (see core/RenderState.hpp): written after the render, and resumed from before it
+        std::string stateOutPath;
+        std::string resumePath;
     };
 
     class ArgumentsParser
@@ -0,0 +1,87 @@
+#ifndef NFRACT_H
+#define NFRACT_H
+
+/* C interface of nfract for FFI callers (ctypes, cgo, ...). Images are RGBA8 and written straight into caller-owned
+ * memory: row y of the image starts at out + y * stride. Every function may be called from several threads at once. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(NFRACT_BUILDING_SHARED)
+#    define NFRACT_API __declspec(dllexport)
+#  else
+#    define NFRACT_API __declspec(dllimport)
+#  endif
+#else
+#  define NFRACT_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum nfract_status
+{
+    NFRACT_OK = 0,
+    NFRACT_ERROR_INVALID_ARGUMENT = -1, /* null pointer, bad size, stride shorter than a row, malformed polynomial */
+    NFRACT_ERROR_INTERNAL = -2
+};
+
+enum nfract_color_mode
+{
+    NFRACT_COLOR_JEWELRY = 0,
+    NFRACT_COLOR_NEON = 1,
+    NFRACT_COLOR_CLASSIC = 2,
+    NFRACT_COLOR_EQUALIZED = 3 /* brightness by the rank of the iteration count within the frame */
+};
+
+enum nfract_method
+{
+    NFRACT_METHOD_NEWTON = 0,
+    NFRACT_METHOD_HALLEY = 1,
+    NFRACT_METHOD_HOUSEHOLDER3 = 2,
+    NFRACT_METHOD_SCHRODER = 3
+};
+
+/* Start from nfract_params_init() and override fields. The polynomial is the first of expression, coefficients and
+ * roots that is set, or z^degree - 1 when none is. Rendering is single precision. */
+typedef struct nfract_params
+{
+    int degree;
+    int width;
+    int height;
+    int max_iter; /* 1 .. 10000 */
+    float xmin; /* finite, xmin < xmax and ymin < ymax */
+    float xmax;
+    float ymin;
+    float ymax;
+    float tolerance; /* 1e-6 .. 1e-2 */
+    int color_mode; /* enum nfract_color_mode */
+    int method; /* enum nfract_method */
+    const double* coefficients; /* num_coefficients interleaved (re, im) pairs, highest degree first, all finite */
+    int num_coefficients; /* >= 0 */
+    const double* roots; /* num_roots interleaved finite (re, im) pairs */
+    int num_roots; /* >= 0 */
+    const char* expression; /* NUL-terminated formula in z, e.g. "z^7 + 3z^2 - 1" */
+} nfract_params;
+
+/* The defaults of the nfract command line */
+NFRACT_API void nfract_params_init(nfract_params* params);
+
+/* Renders into out with a process-wide renderer that owns a thread pool and caches the roots of recent polynomials */
+NFRACT_API int nfract_render(const nfract_params* params, uint8_t* out, size_t stride);
+
+/* A renderer of its own, e.g. to size its thread pool (threads == 0: one per hardware thread) */
+typedef struct nfract_renderer nfract_renderer;
+NFRACT_API nfract_renderer* nfract_renderer_create(int threads);
+NFRACT_API void nfract_renderer_destroy(nfract_renderer* renderer);
+NFRACT_API int nfract_renderer_render(nfract_renderer* renderer, const nfract_params* params, uint8_t* out, size_t stride);
+
+NFRACT_API const char* nfract_version(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace nfract
+{
+    /// Allocator whose storage starts on an `Alignment` byte boundary, e.g. a cache line for pixel buffers
+    template <typename T, std::size_t Alignment>
+    struct AlignedAllocator
+    {
+        static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+        {
+        }
+
+        [[nodiscard]] T* allocate(const std::size_t n)
+        {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        void deallocate(T* p, std::size_t) noexcept
+        {
+            ::operator delete(p, std::align_val_t{Alignment});
+        }
+
+        template <typename U>
+        [[nodiscard]] bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+        {
+            return true;
+        }
+    };
+}
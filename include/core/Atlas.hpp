@@ -0,0 +1,31 @@
+#pragma once
+
+#include <span>
+
+#include "core/Image.hpp"
+#include "core/RenderParams.hpp"
+#include "core/Renderer.hpp"
+
+namespace nfract
+{
+    /// One thumbnail of an atlas: z^degree - 1 over the given bounds in the given palette
+    struct AtlasCell
+    {
+        int degree = 5;
+        float xmin = -2.0f;
+        float xmax = 2.0f;
+        float ymin = -2.0f;
+        float ymax = 2.0f;
+        ColorMode colorMode = ColorMode::CLASSIC;
+    };
+
+    /// Rows of cells needed for `cells` cells with `columns` cells per row
+    [[nodiscard]] int atlas_rows(int cells, int columns) noexcept;
+
+    /// Renders every cell into its slot of `atlas`, cells laid out row-major with `columns` per row, each
+    /// base.width x base.height pixels; the other fields of `base` apply to every cell. `atlas` must be
+    /// base.width * columns by base.height * atlas_rows(...) pixels. Cells are independent tiles spread over the
+    /// renderer's pool and written in place; the roots of each distinct degree are found once up front and shared by
+    /// all cells of that degree. Slots past the last cell stay untouched.
+    void render_atlas(Renderer& renderer, const RenderParams& base, std::span<const AtlasCell> cells, int columns, Image& atlas);
+}
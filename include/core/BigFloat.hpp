@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace nfract
+{
+    /// Arbitrary precision binary floating point number used for perturbation reference orbits.
+    /// The value is mantissa * 2^exponent, where the mantissa is an unsigned integer of limbs() 32-bit limbs whose
+    /// top bit is set (or all zero for 0). Operations truncate to the larger precision of their operands.
+    class BigFloat
+    {
+    public:
+        using limb_type = std::uint32_t;
+
+        BigFloat() = default;
+        explicit BigFloat(int limbs);
+        BigFloat(double value, int limbs);
+
+        /// Parses a decimal literal at the requested precision; throws std::invalid_argument on malformed text.
+        [[nodiscard]] static BigFloat parse(std::string_view text, int limbs);
+
+        [[nodiscard]] int limbs() const noexcept;
+        [[nodiscard]] bool is_zero() const noexcept;
+        [[nodiscard]] bool negative() const noexcept;
+
+        /// Nearest double (saturates to +-inf or flushes to 0 outside the double range).
+        [[nodiscard]] double to_double() const noexcept;
+
+        [[nodiscard]] BigFloat reciprocal() const;
+
+        friend BigFloat operator+(const BigFloat& a, const BigFloat& b);
+        friend BigFloat operator-(const BigFloat& a, const BigFloat& b);
+        friend BigFloat operator*(const BigFloat& a, const BigFloat& b);
+        friend BigFloat operator/(const BigFloat& a, const BigFloat& b);
+        friend BigFloat operator-(const BigFloat& a);
+
+        friend bool operator<(const BigFloat& a, const BigFloat& b) noexcept;
+
+    private:
+        [[nodiscard]] static int compare_magnitude(const BigFloat& a, const BigFloat& b) noexcept;
+        [[nodiscard]] static BigFloat add_magnitudes(const BigFloat& a, const BigFloat& b, bool subtract);
+        [[nodiscard]] BigFloat with_limbs(int limbs) const;
+        void normalize(std::vector<limb_type>& wide, std::int64_t exponent);
+
+        bool m_negative = false;
+        std::int64_t m_exponent = 0;
+        std::vector<limb_type> m_mantissa; // least significant limb first
+    };
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+
+#include "core/Image.hpp"
+#include "core/RenderParams.hpp"
+#include "core/Renderer.hpp"
+
+namespace nfract
+{
+    /// What DeadlineRenderer::render() rendered, and what it gave up to meet the deadline
+    struct DeadlineReport
+    {
+        double previewMs = 0.0; // time spent on the cost probe
+        double estimatedMs = 0.0; // predicted time of the full-quality render
+        double elapsedMs = 0.0; // total time, probe and upscaling included
+        int width = 0; // resolution actually rendered, upscaled to the requested size when smaller
+        int height = 0;
+        int maxIter = 0; // iteration cap actually used
+        bool degraded = false; // resolution or maxIter below the request
+        bool fellBack = false; // the planned render missed the deadline; the image is the probe, upscaled
+    };
+
+    /// Renders p into `image` (p.width x p.height), trading quality for time so the call returns within `budget`.
+    /// A probe of about probe_pixels pixels over the same viewport gives the cost per pixel; from it the resolution
+    /// is reduced (down to min_scale per axis, upscaled back with nearest neighbour) and then maxIter capped (down to
+    /// min_iterations) until the predicted time fits. If the planned render still misses the deadline it is
+    /// cancelled between tiles and the probe stands in for it, so there is always an image. Tiles are bands of
+    /// Renderer::band_rows rows with either backend, so the overrun is at most one band per thread; a perturbation
+    /// render is a single tile, so its overrun is only bounded by the plan's estimate.
+    class DeadlineRenderer
+    {
+    public:
+        static constexpr int probe_pixels = 64 * 64;
+        static constexpr float min_scale = 0.25f;
+        static constexpr int min_iterations = 16;
+        static constexpr double planning_margin = 0.8; // share of the remaining budget the plan may use
+
+        DeadlineRenderer() = delete;
+
+        static DeadlineReport render(Renderer& renderer, const RenderParams& p, std::chrono::milliseconds budget, Image& image);
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace nfract
+{
+    /// A decimal number split into its significant digits and a power of ten: value = ±digits * 10^exponent.
+    /// Shared by the extended precision types so every kernel reads typed bounds the same way.
+    struct DecimalLiteral
+    {
+        bool negative = false;
+        std::string digits;
+        int exponent = 0;
+
+        /// Throws std::invalid_argument when the text is not a plain decimal or scientific literal.
+        [[nodiscard]] static DecimalLiteral parse(std::string_view text);
+    };
+}
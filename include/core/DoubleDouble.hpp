@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cmath>
+#include <string_view>
+
+namespace nfract
+{
+    /// Unevaluated sum hi + lo of two doubles (~106-bit mantissa), used by the deep-zoom kernels.
+    /// All operations are branch-free so they vectorize the same way plain doubles do.
+    struct DoubleDouble
+    {
+        double hi = 0.0;
+        double lo = 0.0;
+
+        constexpr DoubleDouble() noexcept = default;
+
+        constexpr DoubleDouble(const double h) noexcept :
+            hi(h)
+        {
+        }
+
+        constexpr DoubleDouble(const double h, const double l) noexcept :
+            hi(h),
+            lo(l)
+        {
+        }
+
+        /// Parses a decimal literal ("-0.7937005259840997373758528196", "1e-25", ...) without going through double.
+        /// Throws std::invalid_argument when the text is not a number.
+        [[nodiscard]] static DoubleDouble parse(std::string_view text);
+    };
+
+    namespace dd
+    {
+        [[nodiscard]] inline DoubleDouble quick_two_sum(const double a, const double b) noexcept
+        {
+            const double s = a + b;
+            return {s, b - (s - a)};
+        }
+
+        [[nodiscard]] inline DoubleDouble two_sum(const double a, const double b) noexcept
+        {
+            const double s = a + b;
+            const double bb = s - a;
+            return {s, (a - (s - bb)) + (b - bb)};
+        }
+
+        [[nodiscard]] inline DoubleDouble two_prod(const double a, const double b) noexcept
+        {
+            const double p = a * b;
+#if defined(__FMA__) || defined(__aarch64__)
+            return {p, std::fma(a, b, -p)};
+#else
+            // Dekker split: exact on any IEEE double unit, and what the ISPC kernel uses too
+            constexpr double split = 134217729.0; // 2^27 + 1
+            const double ta = split * a;
+            const double ah = ta - (ta - a);
+            const double al = a - ah;
+            const double tb = split * b;
+            const double bh = tb - (tb - b);
+            const double bl = b - bh;
+            return {p, ((ah * bh - p) + ah * bl + al * bh) + al * bl};
+#endif
+        }
+    }
+
+    [[nodiscard]] inline DoubleDouble operator+(const DoubleDouble a, const DoubleDouble b) noexcept
+    {
+        const DoubleDouble s = dd::two_sum(a.hi, b.hi);
+        const DoubleDouble t = dd::two_sum(a.lo, b.lo);
+        DoubleDouble r = dd::quick_two_sum(s.hi, s.lo + t.hi);
+        r = dd::quick_two_sum(r.hi, r.lo + t.lo);
+        return r;
+    }
+
+    [[nodiscard]] inline DoubleDouble operator-(const DoubleDouble a) noexcept
+    {
+        return {-a.hi, -a.lo};
+    }
+
+    [[nodiscard]] inline DoubleDouble operator-(const DoubleDouble a, const DoubleDouble b) noexcept
+    {
+        return a + (-b);
+    }
+
+    [[nodiscard]] inline DoubleDouble operator*(const DoubleDouble a, const DoubleDouble b) noexcept
+    {
+        DoubleDouble p = dd::two_prod(a.hi, b.hi);
+        p.lo += a.hi * b.lo + a.lo * b.hi;
+        return dd::quick_two_sum(p.hi, p.lo);
+    }
+
+    [[nodiscard]] inline DoubleDouble operator/(const DoubleDouble a, const DoubleDouble b) noexcept
+    {
+        // Long division with two correction terms, accurate to a few ulps of the 106-bit result
+        const double q1 = a.hi / b.hi;
+        DoubleDouble r = a - b * DoubleDouble{q1};
+        const double q2 = r.hi / b.hi;
+        r = r - b * DoubleDouble{q2};
+        const double q3 = r.hi / b.hi;
+        return dd::quick_two_sum(q1, q2) + DoubleDouble{q3};
+    }
+
+    [[nodiscard]] inline bool operator<(const DoubleDouble a, const DoubleDouble b) noexcept
+    {
+        return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo);
+    }
+
+    [[nodiscard]] inline bool operator>=(const DoubleDouble a, const DoubleDouble b) noexcept
+    {
+        return !(a < b);
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "core/Jet.hpp"
+
+namespace nfract
+{
+    /// f(z) typed at run time (e.g. "z^7 + 3z^2 - 1"), compiled to a small register bytecode. Registers hold Taylor
+    /// jets (see core/Jet.hpp), so running the program on z + e yields f', f'' and f''' alongside f without a separate
+    /// derivative program. The interpreter runs each instruction over a whole batch of pixels, which pays the dispatch
+    /// once per batch_lanes lanes and leaves element-wise loops the compiler can vectorize.
+    ///
+    /// Grammar: sums, differences and products of z, i and real literals (an imaginary literal is written 2i),
+    /// parentheses, implicit multiplication (3z^2), unary minus, division by constant subexpressions and ^ with a
+    /// constant non-negative integer exponent. The result must be a polynomial of degree >= 1 in z, so its roots can be
+    /// found for colouring.
+    ///
+    /// The text may also use a parameter a, as in "z^3 + (a-1)z - a", to describe a family of polynomials whose
+    /// coefficients are affine in a. Families are only expanded (coefficients() + a parameter_coefficients()), not
+    /// compiled: code() is empty for them.
+    class Expression
+    {
+    public:
+        enum class Op : std::uint8_t
+        {
+            LOAD_Z = 0, // r[dst] = z
+            LOAD_CONST = 1, // r[dst] = constant[a]
+            MOV = 2, // r[dst] = r[a]
+            ADD = 3, // r[dst] = r[a] + r[b]
+            SUB = 4, // r[dst] = r[a] - r[b]
+            MUL = 5, // r[dst] = r[a] * r[b]
+            NEG = 6, // r[dst] = -r[a]
+            SCALE = 7, // r[dst] = r[a] * constant[b]
+            OFFSET = 8, // r[dst] = r[a] + constant[b]
+        };
+
+        /// Four bytes, so the ISPC kernel can read the program as a plain byte array
+        struct Instruction
+        {
+            Op op;
+            std::uint8_t dst;
+            std::uint8_t a;
+            std::uint8_t b;
+        };
+
+        static constexpr int max_registers = 32;
+        static constexpr int max_constants = 256;
+        static constexpr int max_degree = 1024;
+
+        Expression() = default;
+
+        /// Throws std::invalid_argument on malformed text or anything outside the grammar above.
+        [[nodiscard]] static Expression parse(std::string_view text);
+
+        [[nodiscard]] std::span<const Instruction> code() const noexcept;
+        [[nodiscard]] int registers() const noexcept;
+        [[nodiscard]] std::span<const float> constants_re() const noexcept;
+        [[nodiscard]] std::span<const float> constants_im() const noexcept;
+
+        /// True when the text uses the parameter a
+        [[nodiscard]] bool has_parameter() const noexcept;
+
+        /// f expanded to coefficients, highest degree first (what Polynomial and RootsTable expect); for a family, the
+        /// part that does not depend on a
+        [[nodiscard]] std::span<const std::complex<double>> coefficients() const noexcept;
+
+        /// For a family, the coefficients of a, aligned with coefficients(); empty otherwise
+        [[nodiscard]] std::span<const std::complex<double>> parameter_coefficients() const noexcept;
+
+        /// Runs the program on z + e for batch_lanes lanes. `scratch` must hold registers() entries; the jet of f is
+        /// left in scratch[0].
+        template <int Order>
+        void evaluate(const float* z_re, const float* z_im, std::span<JetBatch<Order>> scratch) const noexcept;
+
+    private:
+        std::vector<Instruction> m_code;
+        int m_registers = 0;
+        std::vector<float> m_constants_re;
+        std::vector<float> m_constants_im;
+        std::vector<std::complex<double>> m_coefficients;
+        std::vector<std::complex<double>> m_parameter_coefficients;
+    };
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace nfract
+{
+    /// Polynomial stand-ins for std::log2 and std::cos in the neon and jewelry palettes (--fast-math-shading). Both are
+    /// a few multiply-adds with no calls or tables, so they inline and vectorize; src/kernel/Newton.ispc has the same
+    /// code operation for operation, so the two backends shade alike.
+
+    /// log2 of a positive normal float, within 5e-8 of the exact value plus rounding. x = m 2^e with m in
+    /// [sqrt(1/2), sqrt(2)), and ln m = 2 atanh(s) = 2 (s + s^3/3 + s^5/5 + s^7/7 + ...) for s = (m - 1) / (m + 1),
+    /// |s| < 0.172, so the terms left out stay below 2 s^9 / 9.
+    [[nodiscard]] inline float fast_log2(const float x) noexcept
+    {
+        const auto bits = std::bit_cast<std::uint32_t>(x);
+        int e = static_cast<int>((bits >> 23) & 0xFFu) - 127;
+        float m = std::bit_cast<float>((bits & 0x007FFFFFu) | 0x3F800000u);
+        if (m > 1.41421356f)
+        {
+            m *= 0.5f;
+            e += 1;
+        }
+        const float s = (m - 1.0f) / (m + 1.0f);
+        const float s2 = s * s;
+        const float ln_m = s * (2.0f + s2 * (0.666666667f + s2 * (0.4f + s2 * 0.285714286f)));
+        return static_cast<float>(e) + ln_m * 1.44269504f;
+    }
+
+    /// cos x for |x| below 1e9, within 1e-7 plus the rounding of the argument reduction, about |x| 2^-24. x is reduced
+    /// to r in [0, 1/2] turns by truncating conversions (std::floor is a library call without SSE4.1), and
+    /// cos(2 pi r) = -sin(u) with u = 2 pi (r - 1/4) in [-pi/2, pi/2], where the Taylor series of sin up to u^11 leaves
+    /// out less than (pi/2)^13 / 13!.
+    [[nodiscard]] inline float fast_cos(const float x) noexcept
+    {
+        const float turns = std::fabs(x * 0.159154943f);
+        float r = turns - static_cast<float>(static_cast<int>(turns));
+        r = r > 0.5f ? 1.0f - r : r;
+        const float u = 6.28318531f * (r - 0.25f);
+        const float u2 = u * u;
+        const float sin_u = u * (1.0f + u2 * (-0.166666667f + u2 * (8.33333333e-3f + u2 * (-1.98412698e-4f + u2 * (2.75573192e-6f + u2 * -2.50521084e-8f)))));
+        return -sin_u;
+    }
+}
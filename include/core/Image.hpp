@@ -1,22 +1,41 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <span>
 #include <filesystem>
 #include <optional>
 
+#include "core/AlignedAllocator.hpp"
+#include "core/ImageView.hpp"
+
 namespace nfract
 {
+    /// RGBA8 pixels in storage that starts on a cache line. Rows are width * 4 bytes apart unless a longer stride is
+    /// given; padded_stride() also starts every row on a cache line, so the threads of adjacent bands never write to
+    /// the same line and row-wise vector stores are aligned.
     class Image
     {
     public:
         using pixel_type = std::uint8_t;
 
+        /// Bytes of a cache line, the alignment of the storage and of padded rows
+        static constexpr std::size_t alignment = 64;
+
         Image() = default;
+        /// Tightly packed rows
         explicit Image(int width, int height);
+        /// Rows `stride` bytes apart, which must be at least width * 4; the bytes past a row's pixels are zero
+        Image(int width, int height, std::size_t stride);
+
+        /// width * 4 rounded up to a whole number of cache lines
+        [[nodiscard]] static std::size_t padded_stride(int width) noexcept;
 
         [[nodiscard]] int width() const noexcept;
         [[nodiscard]] int height() const noexcept;
+        /// Bytes from one row to the next
+        [[nodiscard]] std::size_t stride() const noexcept;
         [[nodiscard]] bool empty() const noexcept;
 
         /// RGBA pixels for row y as a span of size width * 4
@@ -29,15 +48,19 @@ namespace nfract
 
         [[nodiscard]] pixel_type* data() noexcept;
         [[nodiscard]] const pixel_type* data() const noexcept;
+        /// All stride() * height() bytes, row padding included
         [[nodiscard]] std::span<pixel_type> pixels() noexcept;
         [[nodiscard]] std::span<const pixel_type> pixels() const noexcept;
+        /// All the pixels as a view, for the renderers and for sub-views of tiles
+        [[nodiscard]] ImageView view() noexcept;
 
-        /// Save as PNG (RGBA8). Returns true on success.
+        /// Save as PNG (RGBA8), reading rows stride_bytes apart (stride() by default). Returns true on success.
         [[nodiscard]] bool save_png(const std::filesystem::path& path, std::optional<int> stride_bytes = std::nullopt) const noexcept;
 
     private:
         int m_width = 0;
         int m_height = 0;
-        std::vector<pixel_type> m_pixels;
+        std::size_t m_stride = 0;
+        std::vector<pixel_type, AlignedAllocator<pixel_type, alignment>> m_pixels;
     };
 }
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nfract
+{
+    /// Non-owning window on RGBA8 pixels: width x height pixels, row y starting stride bytes after row 0. It is the
+    /// currency between the renderers, their tiles and the caller's memory, whether an Image, a region of one or an
+    /// external buffer. Access is unchecked, so pixel loops stay plain pointer arithmetic; a view is checked once with
+    /// valid() where it enters the renderer.
+    class ImageView
+    {
+    public:
+        using pixel_type = std::uint8_t;
+
+        constexpr ImageView() noexcept = default;
+
+        constexpr ImageView(pixel_type* data, const int width, const int height, const std::size_t stride) noexcept :
+            m_data(data),
+            m_width(width),
+            m_height(height),
+            m_stride(stride)
+        {
+        }
+
+        /// Tightly packed rows
+        constexpr ImageView(pixel_type* data, const int width, const int height) noexcept :
+            ImageView(data, width, height, static_cast<std::size_t>(width > 0 ? width : 0) * 4u)
+        {
+        }
+
+        [[nodiscard]] constexpr pixel_type* data() const noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr int width() const noexcept
+        {
+            return m_width;
+        }
+
+        [[nodiscard]] constexpr int height() const noexcept
+        {
+            return m_height;
+        }
+
+        /// Bytes from one row to the next
+        [[nodiscard]] constexpr std::size_t stride() const noexcept
+        {
+            return m_stride;
+        }
+
+        /// Bytes of pixels in a row, width * 4
+        [[nodiscard]] constexpr std::size_t row_bytes() const noexcept
+        {
+            return static_cast<std::size_t>(m_width) * 4u;
+        }
+
+        /// Non-empty, with rows that do not overlap
+        [[nodiscard]] constexpr bool valid() const noexcept
+        {
+            return m_data != nullptr && m_width > 0 && m_height > 0 && m_stride >= row_bytes();
+        }
+
+        /// First channel of pixel (0, y)
+        [[nodiscard]] constexpr pixel_type* row(const int y) const noexcept
+        {
+            return m_data + static_cast<std::size_t>(y) * m_stride;
+        }
+
+        /// First channel of pixel (x, y) (4 bytes: R,G,B,A)
+        [[nodiscard]] constexpr pixel_type* pixel(const int x, const int y) const noexcept
+        {
+            return row(y) + static_cast<std::size_t>(x) * 4u;
+        }
+
+        /// The width x height pixels from (x, y), sharing this view's rows
+        [[nodiscard]] constexpr ImageView sub(const int x, const int y, const int width, const int height) const noexcept
+        {
+            return {pixel(x, y), width, height, m_stride};
+        }
+
+    private:
+        pixel_type* m_data = nullptr;
+        int m_width = 0;
+        int m_height = 0;
+        std::size_t m_stride = 0;
+    };
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "core/RenderParams.hpp"
+#include "core/Renderer.hpp"
+
+namespace nfract
+{
+    /// What IterationBudget::choose() found in its probe
+    struct IterationChoice
+    {
+        int maxIter = 0; // the chosen budget
+        double coverage = 0.0; // share of the probe's converging pixels that converge within maxIter
+        double converging = 0.0; // share of the probe's pixels that converge within the ceiling at all
+        int probeWidth = 0;
+        int probeHeight = 0;
+    };
+
+    /// Picks the iteration budget from the view instead of a guess. A probe of about probe_pixels pixels over the same
+    /// viewport is iterated with the ceiling budget, and the histogram of the iteration counts of its converging pixels
+    /// gives the smallest budget within which `coverage` of them converge. Pixels that do not converge within the
+    /// ceiling cost the whole budget whatever it is, so they are left out of the share; if none converge the ceiling
+    /// is returned.
+    class IterationBudget
+    {
+    public:
+        static constexpr int probe_pixels = 96 * 96;
+        static constexpr int ceiling = 10'000;
+        static constexpr double default_coverage = 0.999;
+
+        IterationBudget() = delete;
+
+        [[nodiscard]] static IterationChoice choose(Renderer& renderer, const RenderParams& p, double coverage = default_coverage);
+    };
+}
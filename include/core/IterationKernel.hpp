@@ -0,0 +1,499 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <span>
+
+#include "core/Expression.hpp"
+#include "core/Jet.hpp"
+#include "core/Polynomial.hpp"
+#include "core/RootsTable.hpp"
+
+namespace nfract
+{
+    // Building blocks of the single precision CPU kernels. A kernel is a function family, a step rule and a classifier,
+    // all resolved at compile time so each combination gets its own fully inlined pixel loop.
+    //
+    // Function family: `template <int Order> bool evaluate(Complex z, float tol2, Jet<Order>& f) const` fills the
+    //   Taylor jet of f at z (any nonzero multiple of it will do, the step rules only use ratios) and returns false
+    //   once z counts as converged.
+    // Step rule: `static constexpr int order` derivatives and `bool operator()(const Jet<order>& f, Complex& dz) const`
+    //   computing z -= dz, returning false when no step can be taken.
+    // Classifier: `void operator()(Complex z, float& hue, float& dist2) const` names the root z ended up at by a hue in
+    //   [0, 1) and gives the squared distance to it.
+
+    /// Family for any callable written once over a generic number type (`template <typename T> T operator()(const T&)`):
+    /// derivatives come from evaluating it on jets, i.e. forward-mode automatic differentiation. Converged once
+    /// |f(z)| < tol.
+    template <typename Fn>
+    struct AutoDiff
+    {
+        Fn fn;
+
+        template <int Order>
+        [[nodiscard]] bool evaluate(const Complex z, const float tol2, Jet<Order>& f) const noexcept
+        {
+            f = fn(Jet<Order>::variable(z));
+            return abs2(f[0]) >= tol2;
+        }
+    };
+
+    template <typename Fn>
+    AutoDiff(Fn) -> AutoDiff<Fn>;
+
+    /// z^n - 1
+    struct UnityFunction
+    {
+        int degree;
+
+        template <typename T>
+        [[nodiscard]] T operator()(const T& z) const noexcept
+        {
+            return pow_int(z, degree) - 1.0f;
+        }
+    };
+
+    /// Convergence test for polynomials whose f' at the roots can be anything: true once the Newton step |f / f'| is
+    /// below tol / degree. Near a root of multiplicity m <= degree, z is then about m |f / f'| < tol from it, as the
+    /// classifier requires, and scaling f changes nothing. (|f| < tol alone stops short wherever |f'| < 1 at a root.)
+    /// For z^n - 1, where |f'| is about n at the roots, it is the |f| < tol test of UnityFunction.
+    [[nodiscard]] inline bool newton_step_converged(const Complex f, const Complex fp, const float tol2, const int degree) noexcept
+    {
+        const float n = static_cast<float>(degree);
+        return n * n * abs2(f) < tol2 * abs2(fp);
+    }
+
+    /// Arbitrary polynomial evaluated with Horner's scheme. Order 1 runs f and f' as two independent chains over the
+    /// precomputed derivative coefficients so they interleave; higher orders run Horner on jets, which is the nested
+    /// f, f', f''/2, f'''/6 recurrence. Converged by newton_step_converged().
+    struct HornerFunction
+    {
+        const Polynomial& poly;
+
+        template <int Order>
+        [[nodiscard]] bool evaluate(const Complex z, const float tol2, Jet<Order>& f) const noexcept
+        {
+            const int n = poly.degree();
+            const float* a_re = poly.re().data();
+            const float* a_im = poly.im().data();
+
+            if constexpr (Order == 1)
+            {
+                const float* b_re = poly.derivative_re().data();
+                const float* b_im = poly.derivative_im().data();
+
+                Complex fz{a_re[0], a_im[0]};
+                Complex fpz{b_re[0], b_im[0]};
+                for (int k = 1; k < n; ++k)
+                {
+                    fz = mul(fz, z);
+                    fz.re += a_re[k];
+                    fz.im += a_im[k];
+                    fpz = mul(fpz, z);
+                    fpz.re += b_re[k];
+                    fpz.im += b_im[k];
+                }
+                fz = mul(fz, z);
+                fz.re += a_re[n];
+                fz.im += a_im[n];
+
+                f[0] = fz;
+                f[1] = fpz;
+            }
+            else
+            {
+                const Jet<Order> x = Jet<Order>::variable(z);
+                f = Jet<Order>::constant({a_re[0], a_im[0]});
+                for (int k = 1; k <= n; ++k)
+                {
+                    f = f * x + Complex{a_re[k], a_im[k]};
+                }
+            }
+            return !newton_step_converged(f[0], f[1], tol2, n);
+        }
+    };
+
+    /// Polynomial given by its roots, never expanded: with L_j = sum (z - r_k)^-j the jet of f / f(z) is
+    /// 1, L1, (L1^2 - L2) / 2, (L1^3 - 3 L1 L2 + 2 L3) / 6, so high degrees cannot overflow. Converged once z is
+    /// within tol of a root.
+    struct RootsFunction
+    {
+        const RootsTable& roots;
+
+        template <int Order>
+        [[nodiscard]] bool evaluate(const Complex z, const float tol2, Jet<Order>& f) const noexcept
+        {
+            static_assert(Order >= 1 && Order <= 3, "RootsFunction provides up to the third derivative");
+
+            const float* r_re = roots.re().data();
+            const float* r_im = roots.im().data();
+            const int n = roots.size();
+
+            // L1 = sum (z - r)^-1 = sum conj(z - r) / |z - r|^2
+            Complex l1{0.0f, 0.0f};
+            float nearest2 = std::numeric_limits<float>::max();
+            for (int k = 0; k < n; ++k)
+            {
+                const float dr = z.re - r_re[k];
+                const float di = z.im - r_im[k];
+                const float d2 = dr * dr + di * di;
+                const float inv = 1.0f / d2;
+                l1.re += dr * inv;
+                l1.im -= di * inv;
+                nearest2 = std::min(nearest2, d2);
+            }
+
+            if (nearest2 < tol2)
+            {
+                return false;
+            }
+
+            f[0] = {1.0f, 0.0f};
+            f[1] = l1;
+            if constexpr (Order >= 2)
+            {
+                Complex l2{0.0f, 0.0f};
+                Complex l3{0.0f, 0.0f};
+                for (int k = 0; k < n; ++k)
+                {
+                    const Complex inv = div({1.0f, 0.0f}, {z.re - r_re[k], z.im - r_im[k]});
+                    const Complex inv2 = mul(inv, inv);
+                    l2 = l2 + inv2;
+                    if constexpr (Order >= 3)
+                    {
+                        l3 = l3 + mul(inv2, inv);
+                    }
+                }
+
+                const Complex l1_2 = mul(l1, l1);
+                f[2] = 0.5f * (l1_2 - l2);
+                if constexpr (Order >= 3)
+                {
+                    f[3] = (1.0f / 6.0f) * (mul(l1_2, l1) - 3.0f * mul(l1, l2) + 2.0f * l3);
+                }
+            }
+            return true;
+        }
+    };
+
+    /// z -= f / f'
+    struct NewtonStep
+    {
+        static constexpr int order = 1;
+
+        [[nodiscard]] bool operator()(const Jet<order>& f, Complex& dz) const noexcept
+        {
+            const float denom2 = abs2(f[1]);
+            if (denom2 < 1e-12f)
+            {
+                return false;
+            }
+
+            // f / f' = (a+ib)/(c+id) = ((ac+bd) + i(bc-ad)) / (c^2+d^2)
+            const float a = f[0].re;
+            const float b = f[0].im;
+            const float c = f[1].re;
+            const float d = f[1].im;
+
+            const float invDen = 1.0f / denom2;
+            dz = {
+                (a * c + b * d) * invDen,
+                (b * c - a * d) * invDen
+            };
+            return true;
+        }
+    };
+
+    namespace detail
+    {
+        /// Newton step u = f/f' and the corrections t2 = u f''/f', t3 = u^2 f'''/f' the higher order rules are built
+        /// from. Returns false when f' vanishes.
+        template <int Order>
+        [[nodiscard]] bool newton_terms(const Jet<Order>& f, Complex& u, Complex& t2, Complex& t3) noexcept
+        {
+            if (abs2(f[1]) < 1e-12f)
+            {
+                return false;
+            }
+
+            // One reciprocal of f' serves all three ratios
+            const Complex inv = div({1.0f, 0.0f}, f[1]);
+            u = mul(f[0], inv);
+            const Complex u_inv = mul(u, inv);
+            t2 = 2.0f * mul(u_inv, f[2]);
+            if constexpr (Order >= 3)
+            {
+                t3 = 6.0f * mul(mul(u, u_inv), f[3]);
+            }
+            return true;
+        }
+
+        /// dz = u num / den, falling back to the Newton step where den vanishes
+        [[nodiscard]] inline Complex corrected(const Complex u, const Complex num, const Complex den) noexcept
+        {
+            return abs2(den) < 1e-12f ? u : div(mul(u, num), den);
+        }
+    }
+
+    /// 2 f f' / (2 f'^2 - f f''), cubic convergence
+    struct HalleyStep
+    {
+        static constexpr int order = 2;
+
+        [[nodiscard]] bool operator()(const Jet<order>& f, Complex& dz) const noexcept
+        {
+            Complex u{}, t2{}, t3{};
+            if (!detail::newton_terms(f, u, t2, t3))
+            {
+                return false;
+            }
+            dz = detail::corrected(u, {1.0f, 0.0f}, Complex{1.0f, 0.0f} - 0.5f * t2);
+            return true;
+        }
+    };
+
+    /// f f' / (f'^2 - f f''), quadratic even at multiple roots
+    struct SchroderStep
+    {
+        static constexpr int order = 2;
+
+        [[nodiscard]] bool operator()(const Jet<order>& f, Complex& dz) const noexcept
+        {
+            Complex u{}, t2{}, t3{};
+            if (!detail::newton_terms(f, u, t2, t3))
+            {
+                return false;
+            }
+            dz = detail::corrected(u, {1.0f, 0.0f}, Complex{1.0f, 0.0f} - t2);
+            return true;
+        }
+    };
+
+    /// (6 f f'^2 - 3 f^2 f'') / (6 f'^3 - 6 f f' f'' + f^2 f'''), quartic convergence
+    struct Householder3Step
+    {
+        static constexpr int order = 3;
+
+        [[nodiscard]] bool operator()(const Jet<order>& f, Complex& dz) const noexcept
+        {
+            Complex u{}, t2{}, t3{};
+            if (!detail::newton_terms(f, u, t2, t3))
+            {
+                return false;
+            }
+            dz = detail::corrected(u, Complex{1.0f, 0.0f} - 0.5f * t2, Complex{1.0f, 0.0f} - t2 + (1.0f / 6.0f) * t3);
+            return true;
+        }
+    };
+
+    /// Classifier for a known set of roots: hue index / size of the closest entry of a RootsTable
+    struct NearestRoot
+    {
+        const RootsTable& roots;
+
+        /// Index of and squared distance to the closest root
+        [[nodiscard]] int nearest(const Complex z, float& dist2) const noexcept
+        {
+            const auto roots_re = roots.re();
+            const auto roots_im = roots.im();
+
+            int index = 0;
+            dist2 = std::numeric_limits<float>::max();
+            for (int k = 0; k < roots.size(); ++k)
+            {
+                const float dxr = z.re - roots_re[static_cast<std::size_t>(k)];
+                const float dyr = z.im - roots_im[static_cast<std::size_t>(k)];
+                const float d2 = dxr * dxr + dyr * dyr;
+
+                if (d2 < dist2)
+                {
+                    dist2 = d2;
+                    index = k;
+                }
+            }
+            return index;
+        }
+
+        void operator()(const Complex z, float& hue, float& dist2) const noexcept
+        {
+            const int index = nearest(z, dist2);
+            hue = roots.size() > 0 ? static_cast<float>(index) / static_cast<float>(roots.size()) : 0.0f;
+        }
+    };
+
+    /// Classifier for roots that are not known up front, as in a parameter plane where they move with every pixel. The
+    /// hue is the argument of the limit, which varies continuously as the roots do, and the distance to the root is
+    /// estimated by the Newton step |f / f'| there.
+    struct LimitArgument
+    {
+        Jet<1> f; // f and f' at the limit
+
+        void operator()(const Complex z, float& hue, float& dist2) const noexcept
+        {
+            constexpr float two_pi = 6.2831853f;
+            hue = std::atan2(z.im, z.re) / two_pi;
+            if (hue < 0.0f)
+            {
+                hue += 1.0f;
+            }
+            dist2 = abs2(f[1]) > 0.0f ? abs2(div(f[0], f[1])) : std::numeric_limits<float>::max();
+        }
+    };
+
+    // Batched families evaluate batch_lanes pixels per call on structure-of-arrays jets. They suit families that run the
+    // same operations on every lane (an interpreter, per-pixel coefficients), whose per-operation overhead is then paid
+    // once per batch:
+    //   `void start(const float* c_re, const float* c_im, float* z_re, float* z_im)` takes the plane coordinates of the
+    //     batch's pixels and sets their starting points,
+    //   `const JetBatch<Order>& evaluate(const float* z_re, const float* z_im)` evaluates every lane,
+    //   `void classify(int lane, Complex z, float& hue, float& dist2) const` is the classifier for one lane,
+    //   `int degree() const` is the degree in z, for newton_step_converged().
+
+    /// --expr: the bytecode interpreter over pixels of the dynamical plane. The registers live in the family itself, so
+    /// a render allocates nothing.
+    template <int Order>
+    class ExpressionFamily
+    {
+    public:
+        ExpressionFamily(const Expression& expr, const RootsTable& roots) :
+            m_expr(expr),
+            m_roots(roots)
+        {
+        }
+
+        void start(const float* c_re, const float* c_im, float* z_re, float* z_im) const noexcept
+        {
+            std::copy_n(c_re, batch_lanes, z_re);
+            std::copy_n(c_im, batch_lanes, z_im);
+        }
+
+        [[nodiscard]] const JetBatch<Order>& evaluate(const float* z_re, const float* z_im) noexcept
+        {
+            m_expr.evaluate<Order>(z_re, z_im, std::span{m_scratch}.first(static_cast<std::size_t>(m_expr.registers())));
+            return m_scratch.front();
+        }
+
+        void classify([[maybe_unused]] const int lane, const Complex z, float& hue, float& dist2) const noexcept
+        {
+            NearestRoot{m_roots}(z, hue, dist2);
+        }
+
+        [[nodiscard]] int degree() const noexcept
+        {
+            return static_cast<int>(m_expr.coefficients().size()) - 1;
+        }
+
+    private:
+        const Expression& m_expr;
+        const RootsTable& m_roots;
+        std::array<JetBatch<Order>, Expression::max_registers> m_scratch;
+    };
+
+    /// --family: every pixel is a value of the parameter a and runs its own polynomial, with coefficients base + a slope
+    /// computed per lane. Each orbit starts at the free critical point of that polynomial's Newton map, the root of f''
+    /// (closed form for cubics and quartics; for quartics the one taking the + branch of the square root). Where that
+    /// orbit fails to converge Newton's method has an attracting cycle.
+    template <int Order>
+    class ParameterFamily
+    {
+    public:
+        static constexpr int max_terms = 5;
+
+        /// Coefficients highest degree first, both of the same length; the degree in z must be 3 or 4.
+        ParameterFamily(const std::span<const std::complex<double>> base, const std::span<const std::complex<double>> slope) :
+            m_degree(static_cast<int>(base.size()) - 1)
+        {
+            for (std::size_t k = 0; k < base.size(); ++k)
+            {
+                m_base[k] = {static_cast<float>(base[k].real()), static_cast<float>(base[k].imag())};
+                m_slope[k] = {static_cast<float>(slope[k].real()), static_cast<float>(slope[k].imag())};
+            }
+        }
+
+        void start(const float* a_re, const float* a_im, float* z_re, float* z_im) noexcept
+        {
+            for (int k = 0; k <= m_degree; ++k)
+            {
+                const Complex b = m_base[static_cast<std::size_t>(k)];
+                const Complex s = m_slope[static_cast<std::size_t>(k)];
+                for (int l = 0; l < batch_lanes; ++l)
+                {
+                    m_re[k][l] = b.re + (a_re[l] * s.re - a_im[l] * s.im);
+                    m_im[k][l] = b.im + (a_re[l] * s.im + a_im[l] * s.re);
+                }
+            }
+
+            for (int l = 0; l < batch_lanes; ++l)
+            {
+                const std::complex<float> c0{m_re[0][l], m_im[0][l]};
+                const std::complex<float> c1{m_re[1][l], m_im[1][l]};
+                std::complex<float> z;
+                if (m_degree == 3)
+                {
+                    // f'' = 6 c0 z + 2 c1
+                    z = -c1 / (3.0f * c0);
+                }
+                else
+                {
+                    // f'' / 2 = 6 c0 z^2 + 3 c1 z + c2
+                    const std::complex<float> c2{m_re[2][l], m_im[2][l]};
+                    const std::complex<float> qa = 6.0f * c0;
+                    const std::complex<float> qb = 3.0f * c1;
+                    z = (-qb + std::sqrt(qb * qb - 4.0f * qa * c2)) / (2.0f * qa);
+                }
+                z_re[l] = z.real();
+                z_im[l] = z.imag();
+            }
+        }
+
+        /// Horner's scheme on jets, one lane per pixel: f[k] = f[k] z + f[k-1] from the top term down
+        [[nodiscard]] const JetBatch<Order>& evaluate(const float* z_re, const float* z_im) noexcept
+        {
+            m_f = JetBatch<Order>{};
+            m_f.re[0] = m_re[0];
+            m_f.im[0] = m_im[0];
+            for (int j = 1; j <= m_degree; ++j)
+            {
+                for (int k = Order; k >= 0; --k)
+                {
+                    for (int l = 0; l < batch_lanes; ++l)
+                    {
+                        const float re = m_f.re[k][l] * z_re[l] - m_f.im[k][l] * z_im[l];
+                        const float im = m_f.re[k][l] * z_im[l] + m_f.im[k][l] * z_re[l];
+                        m_f.re[k][l] = re + (k > 0 ? m_f.re[k - 1][l] : m_re[j][l]);
+                        m_f.im[k][l] = im + (k > 0 ? m_f.im[k - 1][l] : m_im[j][l]);
+                    }
+                }
+            }
+            return m_f;
+        }
+
+        void classify(const int lane, const Complex z, float& hue, float& dist2) const noexcept
+        {
+            Jet<1> f;
+            f[0] = {m_re[0][lane], m_im[0][lane]};
+            for (int j = 1; j <= m_degree; ++j)
+            {
+                f[1] = mul(f[1], z) + f[0];
+                f[0] = mul(f[0], z) + Complex{m_re[j][lane], m_im[j][lane]};
+            }
+            LimitArgument{f}(z, hue, dist2);
+        }
+
+        [[nodiscard]] int degree() const noexcept
+        {
+            return m_degree;
+        }
+
+    private:
+        int m_degree;
+        std::array<Complex, max_terms> m_base{};
+        std::array<Complex, max_terms> m_slope{};
+        std::array<std::array<float, batch_lanes>, max_terms> m_re{}; // this batch's coefficients, highest degree first
+        std::array<std::array<float, batch_lanes>, max_terms> m_im{};
+        JetBatch<Order> m_f;
+    };
+}
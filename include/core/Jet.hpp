@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+namespace nfract
+{
+    /// Single precision complex number used by the CPU kernels. std::complex<float> multiplication carries NaN
+    /// recovery branches that keep the pixel loops from vectorizing, so the kernels use this plain pair instead.
+    struct Complex
+    {
+        float re;
+        float im;
+    };
+
+    [[nodiscard]] constexpr Complex mul(const Complex a, const Complex b) noexcept
+    {
+        return {
+            a.re * b.re - a.im * b.im,
+            a.re * b.im + a.im * b.re
+        };
+    }
+
+    [[nodiscard]] constexpr float abs2(const Complex z) noexcept
+    {
+        return z.re * z.re + z.im * z.im;
+    }
+
+    /// a / b = a conj(b) / |b|^2
+    [[nodiscard]] constexpr Complex div(const Complex a, const Complex b) noexcept
+    {
+        const float inv = 1.0f / abs2(b);
+        return {
+            (a.re * b.re + a.im * b.im) * inv,
+            (a.im * b.re - a.re * b.im) * inv
+        };
+    }
+
+    [[nodiscard]] constexpr Complex pow_int(const Complex z, const int k) noexcept
+    {
+        Complex res{1.0f, 0.0f};
+        for (int i = 0; i < k; ++i)
+        {
+            res = mul(res, z);
+        }
+        return res;
+    }
+
+    [[nodiscard]] constexpr Complex operator+(const Complex a, const Complex b) noexcept
+    {
+        return {a.re + b.re, a.im + b.im};
+    }
+
+    [[nodiscard]] constexpr Complex operator-(const Complex a, const Complex b) noexcept
+    {
+        return {a.re - b.re, a.im - b.im};
+    }
+
+    [[nodiscard]] constexpr Complex operator-(const Complex a) noexcept
+    {
+        return {-a.re, -a.im};
+    }
+
+    [[nodiscard]] constexpr Complex operator*(const Complex a, const Complex b) noexcept
+    {
+        return mul(a, b);
+    }
+
+    [[nodiscard]] constexpr Complex operator*(const float s, const Complex a) noexcept
+    {
+        return {s * a.re, s * a.im};
+    }
+
+    [[nodiscard]] constexpr Complex operator+(const Complex a, const float b) noexcept
+    {
+        return {a.re + b, a.im};
+    }
+
+    [[nodiscard]] constexpr Complex operator-(const Complex a, const float b) noexcept
+    {
+        return {a.re - b, a.im};
+    }
+
+    /// Truncated Taylor expansion f(z + e) = c[0] + c[1] e + ... + c[Order] e^Order, so c[k] = f^(k)(z) / k!.
+    /// Order 1 is the forward-mode dual number (f, f'); higher orders carry the extra derivatives the Halley and
+    /// Householder steps need. Terms past Order are dropped and every loop has a compile-time trip count.
+    template <int Order>
+    struct Jet
+    {
+        static_assert(Order >= 0);
+        static constexpr int order = Order;
+
+        std::array<Complex, Order + 1> c{};
+
+        /// The independent variable z + e
+        [[nodiscard]] static constexpr Jet variable(const Complex z) noexcept
+        {
+            Jet j;
+            j.c[0] = z;
+            if constexpr (Order >= 1)
+            {
+                j.c[1] = {1.0f, 0.0f};
+            }
+            return j;
+        }
+
+        [[nodiscard]] static constexpr Jet constant(const Complex value) noexcept
+        {
+            Jet j;
+            j.c[0] = value;
+            return j;
+        }
+
+        /// True for z + e as made by variable(), which lets pow_int skip the series composition
+        [[nodiscard]] constexpr bool is_variable() const noexcept
+        {
+            if constexpr (Order >= 1)
+            {
+                if (c[1].re != 1.0f || c[1].im != 0.0f)
+                {
+                    return false;
+                }
+            }
+            for (int k = 2; k <= Order; ++k)
+            {
+                if (c[static_cast<std::size_t>(k)].re != 0.0f || c[static_cast<std::size_t>(k)].im != 0.0f)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] constexpr Complex& operator[](const int k) noexcept
+        {
+            return c[static_cast<std::size_t>(k)];
+        }
+
+        [[nodiscard]] constexpr const Complex& operator[](const int k) const noexcept
+        {
+            return c[static_cast<std::size_t>(k)];
+        }
+    };
+
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator+(const Jet<Order>& a, const Jet<Order>& b) noexcept
+    {
+        Jet<Order> r;
+        for (int k = 0; k <= Order; ++k)
+        {
+            r[k] = a[k] + b[k];
+        }
+        return r;
+    }
+
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator-(const Jet<Order>& a, const Jet<Order>& b) noexcept
+    {
+        Jet<Order> r;
+        for (int k = 0; k <= Order; ++k)
+        {
+            r[k] = a[k] - b[k];
+        }
+        return r;
+    }
+
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator-(const Jet<Order>& a) noexcept
+    {
+        Jet<Order> r;
+        for (int k = 0; k <= Order; ++k)
+        {
+            r[k] = -a[k];
+        }
+        return r;
+    }
+
+    /// Cauchy product truncated to Order
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator*(const Jet<Order>& a, const Jet<Order>& b) noexcept
+    {
+        Jet<Order> r;
+        for (int k = 0; k <= Order; ++k)
+        {
+            Complex sum = mul(a[0], b[k]);
+            for (int i = 1; i <= k; ++i)
+            {
+                sum = sum + mul(a[i], b[k - i]);
+            }
+            r[k] = sum;
+        }
+        return r;
+    }
+
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator*(const Jet<Order>& a, const Complex s) noexcept
+    {
+        Jet<Order> r;
+        for (int k = 0; k <= Order; ++k)
+        {
+            r[k] = mul(a[k], s);
+        }
+        return r;
+    }
+
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator*(const Complex s, const Jet<Order>& a) noexcept
+    {
+        return a * s;
+    }
+
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator+(Jet<Order> a, const Complex b) noexcept
+    {
+        a[0] = a[0] + b;
+        return a;
+    }
+
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator-(Jet<Order> a, const Complex b) noexcept
+    {
+        a[0] = a[0] - b;
+        return a;
+    }
+
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator+(Jet<Order> a, const float b) noexcept
+    {
+        a[0] = a[0] + b;
+        return a;
+    }
+
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> operator-(Jet<Order> a, const float b) noexcept
+    {
+        a[0] = a[0] - b;
+        return a;
+    }
+
+    /// x^k for k >= 0. The Taylor coefficients of t^k at t = x[0] are binom(k, j) x[0]^(k-j), composed with the
+    /// higher terms of x: the cost is one power of x[0] plus O(Order^2) work, not k jet products.
+    template <int Order>
+    [[nodiscard]] constexpr Jet<Order> pow_int(const Jet<Order>& x, const int k) noexcept
+    {
+        const int top = std::min(Order, k);
+
+        // powers[j] = x[0]^(k-j)
+        std::array<Complex, Order + 1> powers{};
+        powers[static_cast<std::size_t>(top)] = pow_int(x[0], k - top);
+        for (int j = top; j > 0; --j)
+        {
+            powers[static_cast<std::size_t>(j - 1)] = mul(powers[static_cast<std::size_t>(j)], x[0]);
+        }
+
+        Jet<Order> result = Jet<Order>::constant(powers[0]);
+        float binom = 1.0f;
+        if (x.is_variable())
+        {
+            // x = z + e, the common case: the coefficients are the Taylor coefficients themselves
+            for (int j = 1; j <= top; ++j)
+            {
+                binom = binom * static_cast<float>(k - j + 1) / static_cast<float>(j);
+                result[j] = binom * powers[static_cast<std::size_t>(j)];
+            }
+            return result;
+        }
+
+        const Jet<Order> h = x - x[0];
+        Jet<Order> hj = h;
+        for (int j = 1; j <= top; ++j)
+        {
+            binom = binom * static_cast<float>(k - j + 1) / static_cast<float>(j);
+            result = result + hj * (binom * powers[static_cast<std::size_t>(j)]);
+            if (j < top)
+            {
+                hj = hj * h;
+            }
+        }
+        return result;
+    }
+
+    /// Lanes per batch in the batched CPU kernels
+    inline constexpr int batch_lanes = 64;
+
+    /// Jets of Lanes independent points as structure of arrays: re[k][lane] + i im[k][lane] is the k-th Taylor
+    /// coefficient of one lane, so element-wise work over a batch is a plain loop over lanes that vectorizes.
+    template <int Order, int Lanes = batch_lanes>
+    struct JetBatch
+    {
+        std::array<std::array<float, Lanes>, Order + 1> re{};
+        std::array<std::array<float, Lanes>, Order + 1> im{};
+    };
+}
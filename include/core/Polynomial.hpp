@@ -0,0 +1,42 @@
+#pragma once
+
+#include <complex>
+#include <span>
+#include <vector>
+
+namespace nfract
+{
+    /// Complex polynomial laid out for the kernels: coefficients highest degree first as separate real/imaginary
+    /// arrays, plus the derivative's coefficients so f and f' can be evaluated as two independent Horner chains.
+    class Polynomial
+    {
+    public:
+        using value_type = float;
+
+        Polynomial() = default;
+        /// Coefficients highest degree first; leading zeros are dropped. Throws std::invalid_argument below degree 1.
+        explicit Polynomial(std::span<const std::complex<double>> coefficients);
+
+        /// z^n - 1
+        [[nodiscard]] static Polynomial unity(int n);
+
+        [[nodiscard]] int degree() const noexcept;
+
+        [[nodiscard]] std::span<const std::complex<double>> coefficients() const noexcept;
+
+        /// degree() + 1 coefficients of f
+        [[nodiscard]] std::span<const value_type> re() const noexcept;
+        [[nodiscard]] std::span<const value_type> im() const noexcept;
+
+        /// degree() coefficients of f'
+        [[nodiscard]] std::span<const value_type> derivative_re() const noexcept;
+        [[nodiscard]] std::span<const value_type> derivative_im() const noexcept;
+
+    private:
+        std::vector<std::complex<double>> m_coefficients;
+        std::vector<value_type> m_re;
+        std::vector<value_type> m_im;
+        std::vector<value_type> m_derivative_re;
+        std::vector<value_type> m_derivative_im;
+    };
+}
@@ -1,12 +1,112 @@
 #pragma once
-#include "app/ArgumentsParser.hpp"
-#include "core/RootsTable.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/Expression.hpp"
 #include "core/Image.hpp"
+#include "core/ImageView.hpp"
+#include "core/Polynomial.hpp"
+#include "core/RenderParams.hpp"
+#include "core/RootsTable.hpp"
 
 namespace nfract
 {
-    void render_newton_cpu(const Arguments& params, const RootsTable& roots, Image& image);
+    /// What the kernels derive from the polynomial rather than from the viewport: the roots used for colouring, plus
+    /// the expanded polynomial (PolynomialForm::COEFFICIENTS), the compiled expression (PolynomialForm::EXPRESSION) or
+    /// the family's coefficients in float (PolynomialForm::FAMILY). Building it is the expensive part of a small render,
+    /// so it is meant to be built once and shared read-only.
+    struct PreparedPolynomial
+    {
+        /// p.coefficients and p.parameterCoefficients of a family, highest degree first, as the ISPC kernel reads them;
+        /// empty unless the family is a cubic or quartic with as many coefficients of a as of 1
+        struct FamilyCoefficients
+        {
+            std::vector<float> base_re;
+            std::vector<float> base_im;
+            std::vector<float> slope_re;
+            std::vector<float> slope_im;
+        };
+
+        RootsTable roots;
+        Polynomial polynomial;
+        Expression expression;
+        FamilyCoefficients family;
+
+        /// Finds the roots of the polynomial p describes (none for PolynomialForm::FAMILY, where they vary per pixel). An
+        /// expression's roots come from its own expansion, not from p.coefficients.
+        [[nodiscard]] static PreparedPolynomial prepare(const RenderParams& p);
+        /// Uses the given roots instead of finding them
+        [[nodiscard]] static PreparedPolynomial prepare(const RenderParams& p, RootsTable roots);
+    };
+
+    /// Rectangle of pixels in the p.width x p.height frame. Pixel (x, y) sits at the same point of the complex plane
+    /// whether it is rendered with the whole frame or with a region, so regions can be rendered separately and pieced
+    /// together.
+    struct PixelRect
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+
+        [[nodiscard]] static PixelRect frame(const RenderParams& p) noexcept;
+
+        /// Non-empty and inside the frame of p
+        [[nodiscard]] bool inside(const RenderParams& p) const noexcept;
+        [[nodiscard]] bool operator==(const PixelRect&) const = default;
+    };
+
+    /// What the iteration left at a pixel, before colouring: the hue of the root it reached (see the classifiers in
+    /// core/IterationKernel.hpp), its squared distance to that root, the iterations it took and where it stopped
+    struct FieldSample
+    {
+        static constexpr int pending = -1; // iter of a sample not computed yet
+
+        float hue = 0.0f;
+        float dist2 = 0.0f;
+        int iter = pending;
+        float zre = 0.0f;
+        float zim = 0.0f;
+    };
+
+    /// ColorMode::EQUALIZED spreads the brightness evenly over the converged pixels of the frame: each one is shaded by
+    /// the share of them that converge faster, i.e. by the rank of its continuous iteration count. The counts are
+    /// binned into equalization_bins bins over [0, p.maxIter].
+    inline constexpr int equalization_bins = 2048;
+
+    /// Adds the converged samples of `region` to `counts` (equalization_bins bins). Threads fill histograms of their own
+    /// and sum them bin by bin; nothing is added when counts has another size.
+    void histogram_field(const RenderParams& p, const PixelRect& region, const FieldSample* field, std::size_t fieldStride, std::span<std::uint32_t> counts) noexcept;
+    /// Turns the summed histogram of the frame into the rank of each bin: the share of samples below it plus half its
+    /// own, in [0, 1]
+    void equalize(std::span<const std::uint32_t> counts, std::span<float> ranks) noexcept;
+
+    void render_newton_cpu(const RenderParams& p, const RootsTable& roots, Image& image);
+    /// The pixels of `region` into `out`, a region.width x region.height view whose pixel (0, 0) is pixel
+    /// (region.x, region.y) of the frame. Perturbation renders need the whole frame as the region. Allocates nothing in
+    /// single precision, except with ColorMode::EQUALIZED, which iterates the whole frame into a field since the ranks
+    /// come from all of it.
+    void render_newton_cpu(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, ImageView out);
+    /// Like render_newton_cpu() for `region`, but keeps the samples at `field` (stride counted in samples) instead of
+    /// colouring them, and only computes those whose iter is FieldSample::pending. Samples that ran out of an earlier,
+    /// smaller budget of `resumeFrom` iterations continue from their z up to p.maxIter, which gives the same result as
+    /// starting over in single precision; the deep-zoom kernels start them over. Perturbation renders need the whole
+    /// frame as the region and compute every sample.
+    void render_field_cpu(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, FieldSample* field, std::size_t fieldStride, int resumeFrom = FieldSample::pending);
+    /// Colours the samples of `region` as a render of p would have; field points at sample (region.x, region.y) and
+    /// out is laid out as for render_newton_cpu(). ColorMode::EQUALIZED needs the ranks of the whole frame (see
+    /// equalize()).
+    void shade_field(const RenderParams& p, const PixelRect& region, const FieldSample* field, std::size_t fieldStride, ImageView out, std::span<const float> ranks = {}) noexcept;
 #ifndef RUN_ON_CPU
-    void render_newton_ispc(const Arguments& p, const RootsTable& roots, Image& image);
+    void render_newton_ispc(const RenderParams& p, const RootsTable& roots, Image& image);
+    /// The whole frame into `out`, a p.width x p.height view
+    void render_newton_ispc(const RenderParams& p, const PreparedPolynomial& prepared, ImageView out);
+    /// `region` laid out as for render_newton_cpu(). Perturbation picks its references from the whole frame and
+    /// ColorMode::EQUALIZED ranks it, so neither has a region kernel; for those nothing is written and false is
+    /// returned.
+    [[nodiscard]] bool render_newton_ispc_region(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, ImageView out);
 #endif
 }
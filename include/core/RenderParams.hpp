@@ -0,0 +1,73 @@
+#pragma once
+
+#include <complex>
+#include <string>
+#include <vector>
+
+namespace nfract
+{
+    enum class ColorMode
+    {
+        JEWELRY = 0,
+        NEON = 1,
+        CLASSIC = 2,
+        EQUALIZED = 3, // hue from the root, value from the rank of the pixel's iteration count within the frame
+    };
+
+    enum class Precision
+    {
+        SINGLE = 0,
+        DOUBLE_DOUBLE = 1,
+        PERTURBATION = 2,
+    };
+
+    enum class Method
+    {
+        NEWTON = 0, // quadratic
+        HALLEY = 1, // cubic, needs f''
+        HOUSEHOLDER3 = 2, // quartic, needs f'''
+        SCHRODER = 3, // quadratic, also at multiple roots
+    };
+
+    enum class PolynomialForm
+    {
+        UNITY = 0, // z^degree - 1
+        COEFFICIENTS = 1, // arbitrary coefficients, evaluated with Horner's scheme
+        ROOTS = 2, // product of (z - r_k), iterated with f/f' = 1 / sum 1/(z - r_k)
+        EXPRESSION = 3, // f typed as text, run by the bytecode interpreter in core/Expression.hpp
+        FAMILY = 4, // parameter plane: coefficients + a parameterCoefficients, a taken from the pixel
+    };
+
+    /// Everything a render depends on: the polynomial, the viewport, the image size and the iteration and colouring
+    /// settings. The command line fills it through Arguments; embedders fill it directly.
+    struct RenderParams
+    {
+        int degree = 5; // n in z^n - 1 = 0
+        int width = 1920;
+        int height = 1080;
+        int maxIter = 100;
+        float xmin = -2.0f;
+        float xmax = 2.0f;
+        float ymin = -2.0f;
+        float ymax = 2.0f;
+        float tolerance = 1e-3f;
+        ColorMode colorMode = ColorMode::CLASSIC;
+        bool fastShading = false; // polynomial log2 and cos in the neon and jewelry palettes (see core/FastMath.hpp)
+        Precision precision = Precision::SINGLE;
+        Method method = Method::NEWTON;
+        PolynomialForm form = PolynomialForm::UNITY;
+        // Fill basin-interior tiles proven to shade alike without iterating their pixels (see core/TileCertifier.hpp);
+        // the image is unchanged. Applies to single precision newton renders of unity and coefficients in the classic
+        // palette, which run on the CPU kernels in ISPC builds too.
+        bool certifyTiles = false;
+        std::vector<std::complex<double>> coefficients; // highest degree first, used by PolynomialForm::COEFFICIENTS and FAMILY
+        std::vector<std::complex<double>> parameterCoefficients; // coefficients of a, used by PolynomialForm::FAMILY
+        std::vector<std::complex<double>> roots; // used by PolynomialForm::ROOTS
+        std::string expression; // used by PolynomialForm::EXPRESSION
+        // Bounds as typed on the command line, read by the deep-zoom kernels; empty means use the float bound
+        std::string xminDecimal;
+        std::string xmaxDecimal;
+        std::string yminDecimal;
+        std::string ymaxDecimal;
+    };
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/RenderNewton.hpp"
+#include "core/RenderParams.hpp"
+
+namespace nfract
+{
+    /// The field of a finished render (see FieldSample), kept so that a later render of the same view with a larger
+    /// max-iter only has to continue the pixels that ran out of iterations. Every sample is stored, since colours
+    /// depend on the budget, but only the pixels that hit max-iter keep the z they stopped at. Alongside the samples
+    /// the state records everything else the field depends on, so it can tell which renders may resume from it.
+    ///
+    /// The file is a short text tag followed by the key and the samples in the machine's own byte order; it is
+    /// meant to be resumed on the machine that wrote it.
+    class RenderState
+    {
+    public:
+        RenderState() = default;
+        /// `field` holds p.width * p.height samples, row by row
+        RenderState(const RenderParams& p, std::vector<FieldSample> field);
+
+        /// Throws std::runtime_error when the file cannot be read, is not a state file or holds a field of another
+        /// size than the frame its key describes
+        [[nodiscard]] static RenderState load(const std::filesystem::path& path);
+        /// Returns true on success
+        [[nodiscard]] bool save(const std::filesystem::path& path) const noexcept;
+
+        /// True when p renders the same field, p.width * p.height samples, with at least as many iterations; the
+        /// palette may differ
+        [[nodiscard]] bool resumable_by(const RenderParams& p) const;
+
+        [[nodiscard]] int max_iter() const noexcept;
+        /// Pixels that ran out of iterations
+        [[nodiscard]] int unconverged() const noexcept;
+        [[nodiscard]] std::vector<FieldSample>& field() noexcept;
+        [[nodiscard]] const std::vector<FieldSample>& field() const noexcept;
+
+    private:
+        std::string m_key; // the RenderParams of the field, apart from max-iter and palette
+        int m_maxIter = 0;
+        std::vector<FieldSample> m_field;
+    };
+}
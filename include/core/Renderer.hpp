@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/Image.hpp"
+#include "core/ImageView.hpp"
+#include "core/RenderNewton.hpp"
+#include "core/RenderParams.hpp"
+#include "core/ThreadPool.hpp"
+
+namespace nfract
+{
+    enum class RenderStatus
+    {
+        COMPLETED = 0,
+        CANCELLED = 1, // some tiles were skipped; the image is incomplete
+    };
+
+    /// Counters a running render shares with its RenderTask. Tiles are counted as they finish and cancellation is
+    /// checked before each tile starts, so both cost one relaxed atomic operation per tile.
+    struct RenderProgress
+    {
+        std::atomic<int> tilesDone{0};
+        std::atomic<int> tilesTotal{0}; // 0 until the render has prepared its polynomial
+        std::atomic<bool> cancelled{false};
+    };
+
+    /// Handle on a render started by Renderer::render_async(). Destroying it cancels the render and waits for the tiles
+    /// already running, so the output buffer may be released right after.
+    class RenderTask
+    {
+    public:
+        RenderTask(std::shared_ptr<RenderProgress> progress, std::future<RenderStatus> result) noexcept;
+        RenderTask(RenderTask&&) noexcept = default;
+        RenderTask& operator=(RenderTask&& other) noexcept;
+        ~RenderTask();
+
+        /// Asks the render to stop before its next tile; tiles already running finish
+        void cancel() noexcept;
+
+        [[nodiscard]] int tiles_done() const noexcept;
+        [[nodiscard]] int tiles_total() const noexcept;
+        /// tiles_done() / tiles_total(), 0 before the total is known
+        [[nodiscard]] float progress() const noexcept;
+
+        [[nodiscard]] bool ready() const;
+        void wait() const;
+        /// True when the render finished before `deadline`
+        [[nodiscard]] bool wait_until(std::chrono::steady_clock::time_point deadline) const;
+        /// Waits for the render. Rethrows what preparing the polynomial threw, e.g. std::invalid_argument.
+        [[nodiscard]] RenderStatus get();
+
+    private:
+        std::shared_ptr<RenderProgress> m_progress;
+        std::future<RenderStatus> m_result;
+    };
+
+    /// Entry point for embedding nfract. A Renderer owns a thread pool, the prepared polynomials (roots, expanded
+    /// coefficients, compiled expressions) of its most recent renders and the staging buffers, and writes into
+    /// memory the caller owns. render() may be called from several threads at once. Once a polynomial has been seen and
+    /// the buffers have grown to the largest image, a single precision render allocates nothing.
+    ///
+    /// Output goes through an ImageView, and each band of band_rows rows gets a sub-view of it on the pool, with
+    /// either backend: the ISPC kernels take a region of the frame as the CPU ones do. Perturbation renders are a
+    /// single tile, since their references come from the whole frame, and their regions are rendered into a staging
+    /// buffer that is then copied out.
+    ///
+    /// ColorMode::EQUALIZED runs as a pipeline of three parallel passes over a field of the whole frame: the iteration
+    /// in bands, a histogram per thread of the iteration counts, summed bin range by bin range, and the shading in
+    /// bands. Only turning the summed histogram into ranks is serial, and it costs equalization_bins steps.
+    class Renderer
+    {
+    public:
+        static constexpr int band_rows = 16;
+        static constexpr std::size_t cache_capacity = 16;
+
+        /// threads as for ThreadPool
+        explicit Renderer(int threads = 0);
+        Renderer(const Renderer&) = delete;
+        Renderer& operator=(const Renderer&) = delete;
+
+        /// Renders p into the p.width x p.height RGBA8 image whose row y starts at out + y * stride. Nothing is written
+        /// when the stride is shorter than a row.
+        void render(const RenderParams& p, std::uint8_t* out, std::size_t stride);
+        /// Renders p into `out`, a p.width x p.height view, with a polynomial the caller prepared and keeps alive
+        /// instead of the cached one
+        void render(const RenderParams& p, const PreparedPolynomial& prepared, ImageView out);
+        /// Renders into `image`, which must be p.width x p.height
+        void render(const RenderParams& p, Image& image);
+        /// Renders only `region` of the frame into `out`, a region.width x region.height view whose pixel (0, 0) is
+        /// pixel (region.x, region.y); the region lands exactly as it would in a render of the whole frame. Nothing is
+        /// written when the region is empty or leaves the frame, or the view is not valid or not the region's size.
+        void render(const RenderParams& p, const PixelRect& region, ImageView out);
+        /// Re-renders `region` of `image`, which must be p.width x p.height, leaving the other pixels as they are
+        void render(const RenderParams& p, const PixelRect& region, Image& image);
+
+        /// Computes the pending samples of the p.width x p.height field at `field` (see render_field_cpu()), in bands on
+        /// the pool, and continues those that ran out of an earlier budget of `resumeFrom` iterations. The field kernels
+        /// are the CPU ones, also in ISPC builds.
+        void render_field(const RenderParams& p, FieldSample* field, std::size_t fieldStride, int resumeFrom = FieldSample::pending);
+
+        /// Colours `region` of the p.width x p.height field at `field` (which points at sample (0, 0)) into `out`, laid
+        /// out as for render(p, region, out), in bands on the pool. ColorMode::EQUALIZED ranks the whole field.
+        void shade_field(const RenderParams& p, const PixelRect& region, const FieldSample* field, std::size_t fieldStride, ImageView out);
+
+        /// Starts render(p, out, stride) on a thread of its own and returns at once. `out` and the renderer must stay
+        /// valid until the task is finished or destroyed. A stride shorter than a row makes get() throw
+        /// std::invalid_argument.
+        [[nodiscard]] RenderTask render_async(RenderParams p, std::uint8_t* out, std::size_t stride);
+
+        [[nodiscard]] ThreadPool& pool() noexcept;
+
+    private:
+        /// The fields of RenderParams that PreparedPolynomial depends on
+        struct CacheEntry
+        {
+            PolynomialForm form;
+            int degree;
+            std::vector<std::complex<double>> coefficients;
+            std::vector<std::complex<double>> parameterCoefficients;
+            std::vector<std::complex<double>> roots;
+            std::string expression;
+            std::shared_ptr<const PreparedPolynomial> prepared;
+
+            [[nodiscard]] bool matches(const RenderParams& p) const noexcept;
+        };
+
+        [[nodiscard]] std::shared_ptr<const PreparedPolynomial> prepared(const RenderParams& p);
+        /// Tiles of `region` on the pool, counted in and cancelled through `progress` when given
+        RenderStatus render_tiles(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, ImageView out, RenderProgress* progress);
+        /// Renders the whole frame into a staging buffer and copies `region` out of it
+        void render_staged(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, ImageView out);
+        /// Buffers of the ColorMode::EQUALIZED passes, kept for the next render like the staging buffers
+        struct Equalization
+        {
+            std::vector<FieldSample> field;
+            std::vector<std::uint32_t> counts; // one histogram per thread, summed into the first
+            std::vector<float> ranks;
+        };
+
+        [[nodiscard]] Equalization acquire_equalization();
+        void release_equalization(Equalization&& buffers);
+        /// ColorMode::EQUALIZED: iterates the whole frame into a field, counting its bands as tiles, and shades `region`
+        RenderStatus render_equalized(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, ImageView out, RenderProgress* progress);
+        /// shade_field() with the caller's buffers for the ranks
+        void shade_bands(const RenderParams& p, const PixelRect& region, const FieldSample* field, std::size_t fieldStride, ImageView out, Equalization& buffers);
+
+        ThreadPool m_pool;
+        std::mutex m_mutex;
+        std::vector<CacheEntry> m_cache; // least recently used first
+        std::vector<std::vector<std::uint8_t>> m_staging; // idle staging buffers
+        std::vector<Equalization> m_equalization; // idle buffers of equalized renders
+    };
+}
@@ -6,6 +6,8 @@
 
 namespace nfract
 {
+    class Polynomial;
+
     class RootsTable
     {
     public:
@@ -13,6 +15,10 @@ namespace nfract
 
         RootsTable() = default;
         explicit RootsTable(int n);
+        /// Roots of an arbitrary polynomial, found numerically
+        explicit RootsTable(const Polynomial& polynomial);
+        /// Explicit roots, e.g. read from --roots-file
+        explicit RootsTable(std::span<const std::complex<double>> roots);
 
         [[nodiscard]] int size() const noexcept;
         [[nodiscard]] bool empty() const noexcept;
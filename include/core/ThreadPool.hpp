@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace nfract
+{
+    /// Fixed set of worker threads shared by every parallel render. parallel_for() publishes its loop as a job that
+    /// lives on the caller's stack and is linked into an intrusive list, so scheduling a loop allocates nothing. The
+    /// calling thread works on its own job too, which keeps nested or concurrent parallel_for() calls from deadlocking.
+    class ThreadPool
+    {
+    public:
+        /// threads == 0 uses one worker per hardware thread, minus the caller
+        explicit ThreadPool(int threads = 0);
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ~ThreadPool();
+
+        /// Threads that run a parallel_for(): the workers plus the caller
+        [[nodiscard]] int concurrency() const noexcept;
+
+        /// Calls body(i) for every i in [0, count), spread over the pool, and returns once all calls have finished.
+        /// The body must not throw.
+        template <typename Body>
+        void parallel_for(const int count, Body&& body)
+        {
+            using Stored = std::remove_reference_t<Body>;
+            Job job;
+            job.body = [](void* context, const int index) { (*static_cast<Stored*>(context))(index); };
+            job.context = const_cast<void*>(static_cast<const void*>(&body));
+            job.count = count;
+            run(job);
+        }
+
+    private:
+        struct Job
+        {
+            void (*body)(void*, int) = nullptr;
+            void* context = nullptr;
+            int count = 0;
+            std::atomic<int> next{0};
+            int active = 0; // workers inside drain(), guarded by m_mutex
+            bool linked = false; // guarded by m_mutex
+            Job* following = nullptr; // guarded by m_mutex
+
+            /// Claims indices until none are left
+            void drain() noexcept;
+        };
+
+        void run(Job& job);
+        void work();
+        void unlink(Job& job) noexcept;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        Job* m_head = nullptr;
+        Job* m_tail = nullptr;
+        bool m_stop = false;
+        std::vector<std::thread> m_workers;
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <complex>
+#include <span>
+#include <vector>
+
+#include "core/RootsTable.hpp"
+
+namespace nfract
+{
+    /// What TileCertifier::certify() proved about a tile
+    struct TileCertificate
+    {
+        bool certified = false;
+        int root = -1; // index into the RootsTable every pixel ends nearest to
+        int firstIter = 0; // every pixel stops after between firstIter and lastIter iterations
+        int lastIter = 0;
+    };
+
+    /// Proves, without iterating a single pixel, where the single precision Newton kernel takes every pixel of a tile.
+    /// The tile's starting points are enclosed in a disc, which is carried through the Newton map N(z) = z - f/f' in
+    /// double: the centre takes an exact step, and the radius is bounded by the mean value theorem with
+    /// |N'| = |f f''| / |f'|^2 over the disc, taken from f's Taylor expansion at the centre, plus a bound on the
+    /// rounding of the float kernel at that step. The disc therefore holds every pixel's float trajectory, and
+    /// |f| and |f'| over it tell at which iterations pixels may pass the tolerance test. A tile is certified once every pixel
+    /// has stopped, each within the tolerance of the same root and nearer to it than to any other.
+    ///
+    /// This is the interval Newton operator in centred (mean value) form, which contracts near a root; plain
+    /// rectangular interval arithmetic grows the enclosure with every step and never certifies anything.
+    class TileCertifier
+    {
+    public:
+        /// Above this degree the Taylor shift of every step costs more than iterating the pixels
+        static constexpr int max_degree = 64;
+
+        /// When the kernel stops a pixel
+        enum class StopTest
+        {
+            RESIDUAL, // |f| < tol, as UnityFunction
+            NEWTON_STEP, // degree |f / f'| < tol, as HornerFunction (see newton_step_converged())
+        };
+
+        /// `coefficients` highest degree first, with the values the float kernel iterates (the float coefficients);
+        /// `roots` as the kernel's classifier holds them. Degrees outside [1, max_degree] certify nothing.
+        TileCertifier(std::span<const std::complex<double>> coefficients, const RootsTable& roots, int maxIter, float tolerance,
+                      StopTest stopTest = StopTest::RESIDUAL);
+
+        /// The disc must contain the float starting point of every pixel of the tile. Not thread-safe: it reuses
+        /// scratch space, so each thread needs its own certifier.
+        [[nodiscard]] TileCertificate certify(std::complex<double> center, double radius);
+
+    private:
+        /// f^(j)(center) / j! for j = 0 .. degree
+        void expand(std::complex<double> center) noexcept;
+
+        /// The root every point of the disc is within the tolerance of and nearest to, as the float classifier
+        /// computes it, or -1
+        [[nodiscard]] int nearest_root(std::complex<double> center, double radius) const noexcept;
+
+        std::vector<std::complex<double>> m_coefficients;
+        std::vector<double> m_magnitudes; // |a_k|, highest degree first
+        const RootsTable& m_roots;
+        int m_maxIter;
+        double m_tol2;
+        StopTest m_stopTest;
+        std::vector<std::complex<double>> m_taylor;
+    };
+}
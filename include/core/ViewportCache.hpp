@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/Image.hpp"
+#include "core/RenderNewton.hpp"
+#include "core/RenderParams.hpp"
+#include "core/Renderer.hpp"
+
+namespace nfract
+{
+    /// How much of a ViewportCache::render() came from the previous frame
+    struct ViewportStats
+    {
+        int reused = 0; // samples copied from the previous frame
+        int computed = 0; // samples iterated
+    };
+
+    /// Keeps the field (see FieldSample) of the last frame an interactive client rendered, so that the next frame only
+    /// iterates the pixels it has not seen yet. Every column and row of the new frame is looked up on the complex-plane
+    /// grid of the previous one; those within max_offset pixels of an old column or row take its samples. A pan by
+    /// whole pixels therefore iterates just the exposed strips, a 2x zoom in reuses every other sample of every other
+    /// row, a 2x zoom out reuses the middle quarter of the frame and a change of palette alone reuses everything.
+    ///
+    /// Reused samples were iterated at the old grid positions, which match the new ones up to float rounding, so a
+    /// pixel on a basin boundary may differ from a fresh render. Reuse needs the same polynomial, method, iteration and
+    /// tolerance settings and, outside single precision, the same viewport. The samples come from the CPU kernels, also
+    /// in ISPC builds.
+    class ViewportCache
+    {
+    public:
+        static constexpr double max_offset = 1e-3;
+
+        /// `renderer` must outlive the cache
+        explicit ViewportCache(Renderer& renderer);
+
+        /// Renders p into the p.width x p.height RGBA8 image whose row y starts at out + y * stride and keeps its field
+        /// for the next call. Nothing is written when the stride is shorter than a row.
+        ViewportStats render(const RenderParams& p, std::uint8_t* out, std::size_t stride);
+        /// Renders into `image`, which must be p.width x p.height
+        ViewportStats render(const RenderParams& p, Image& image);
+
+        /// Forgets the kept field, e.g. to release its memory
+        void clear() noexcept;
+
+    private:
+        /// For each of `count` positions start + step * i, the index of the old position within max_offset of it, or -1
+        static void map_axis(double oldStart, double oldStep, int oldCount, double start, double step, int count, std::vector<int>& map);
+
+        Renderer& m_renderer;
+        RenderParams m_params; // of m_field
+        bool m_valid = false;
+        std::vector<FieldSample> m_field;
+        std::vector<FieldSample> m_next;
+        std::vector<int> m_columns;
+        std::vector<int> m_rows;
+    };
+}
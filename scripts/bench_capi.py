@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""Per-call cost of rendering small tiles through the nfract C interface (libnfract) with ctypes, next to shelling
+out to the nfract binary and reading the PNG back.
+
+Usage: scripts/bench_capi.py [--build-dir build] [--tile 32] [--calls 2000] [--max-iter 20]
+
+Configure the build first (cmake -S . -B build && cmake --build build). When numpy is installed the tiles are
+written straight into a numpy array; otherwise into a ctypes buffer.
+"""
+
+import argparse
+import ctypes
+import pathlib
+import subprocess
+import sys
+import tempfile
+import time
+
+
+class NfractParams(ctypes.Structure):
+    _fields_ = [
+        ("degree", ctypes.c_int),
+        ("width", ctypes.c_int),
+        ("height", ctypes.c_int),
+        ("max_iter", ctypes.c_int),
+        ("xmin", ctypes.c_float),
+        ("xmax", ctypes.c_float),
+        ("ymin", ctypes.c_float),
+        ("ymax", ctypes.c_float),
+        ("tolerance", ctypes.c_float),
+        ("color_mode", ctypes.c_int),
+        ("method", ctypes.c_int),
+        ("coefficients", ctypes.POINTER(ctypes.c_double)),
+        ("num_coefficients", ctypes.c_int),
+        ("roots", ctypes.POINTER(ctypes.c_double)),
+        ("num_roots", ctypes.c_int),
+        ("expression", ctypes.c_char_p),
+    ]
+
+
+def find_library(build_dir: pathlib.Path) -> pathlib.Path:
+    for name in ("libnfract.so", "libnfract.dylib", "nfract.dll"):
+        for candidate in (build_dir / name, build_dir / "Release" / name):
+            if candidate.exists():
+                return candidate
+    sys.exit(f"libnfract not found in {build_dir}; build the nfract_shared target first")
+
+
+def find_binary(build_dir: pathlib.Path) -> pathlib.Path | None:
+    for name in ("nfract", "nfract.exe"):
+        for candidate in (build_dir / name, build_dir / "Release" / name):
+            if candidate.exists():
+                return candidate
+    return None
+
+
+def load(path: pathlib.Path) -> ctypes.CDLL:
+    lib = ctypes.CDLL(str(path))
+    lib.nfract_params_init.argtypes = [ctypes.POINTER(NfractParams)]
+    lib.nfract_params_init.restype = None
+    lib.nfract_render.argtypes = [ctypes.POINTER(NfractParams), ctypes.c_void_p, ctypes.c_size_t]
+    lib.nfract_render.restype = ctypes.c_int
+    lib.nfract_version.restype = ctypes.c_char_p
+    return lib
+
+
+def make_buffer(tile: int):
+    try:
+        import numpy as np
+
+        image = np.zeros((tile, tile, 4), dtype=np.uint8)
+        return image, image.ctypes.data, image.strides[0], "numpy"
+    except ImportError:
+        image = (ctypes.c_uint8 * (tile * tile * 4))()
+        return image, ctypes.addressof(image), tile * 4, "ctypes"
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--build-dir", type=pathlib.Path, default=pathlib.Path("build"))
+    parser.add_argument("--tile", type=int, default=32, help="tile width and height in pixels")
+    parser.add_argument("--calls", type=int, default=2000, help="renders through the C interface")
+    parser.add_argument("--max-iter", type=int, default=20)
+    args = parser.parse_args()
+
+    lib = load(find_library(args.build_dir))
+    params = NfractParams()
+    lib.nfract_params_init(ctypes.byref(params))
+    params.width = params.height = args.tile
+    params.max_iter = args.max_iter
+
+    image, address, stride, kind = make_buffer(args.tile)
+    print(f"nfract {lib.nfract_version().decode()}, {args.tile}x{args.tile} tiles, max-iter {args.max_iter}, {kind} buffer")
+
+    # Warm up the renderer's thread pool and roots cache
+    if lib.nfract_render(ctypes.byref(params), address, stride) != 0:
+        sys.exit("nfract_render failed")
+
+    start = time.perf_counter()
+    for _ in range(args.calls):
+        lib.nfract_render(ctypes.byref(params), address, stride)
+    per_call = (time.perf_counter() - start) / args.calls
+    print(f"ctypes nfract_render:     {per_call * 1e6:10.1f} us/tile")
+
+    # A 1x1 render at one iteration is all call overhead
+    params.width = params.height = 1
+    params.max_iter = 1
+    start = time.perf_counter()
+    for _ in range(args.calls):
+        lib.nfract_render(ctypes.byref(params), address, stride)
+    overhead = (time.perf_counter() - start) / args.calls
+    print(f"ctypes call overhead:     {overhead * 1e6:10.1f} us/call (1x1 pixel, 1 iteration)")
+
+    binary = find_binary(args.build_dir)
+    if binary is None:
+        return
+    runs = max(1, min(50, args.calls // 40))
+    with tempfile.TemporaryDirectory() as tmp:
+        out = pathlib.Path(tmp) / "tile.png"
+        command = [str(binary), "--width", str(args.tile), "--height", str(args.tile),
+                   "--max-iter", str(args.max_iter), "--out", str(out)]
+        start = time.perf_counter()
+        for _ in range(runs):
+            subprocess.run(command, check=True)
+            out.read_bytes()
+        per_process = (time.perf_counter() - start) / runs
+    print(f"nfract process + PNG:     {per_process * 1e6:10.1f} us/tile ({per_process / per_call:.0f}x)")
+
+
+if __name__ == "__main__":
+    main()
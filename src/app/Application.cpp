@@ -1,9 +1,15 @@
 #include "app/Application.hpp"
 
+#include <chrono>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
-#include "core/RenderNewton.hpp"
-#include "core/RootsTable.hpp"
+#include "core/Atlas.hpp"
+#include "core/Deadline.hpp"
+#include "core/IterationBudget.hpp"
+#include "core/RenderState.hpp"
+#include "core/Renderer.hpp"
 
 namespace nfract
 {
@@ -14,15 +20,92 @@ namespace nfract
 
     int Application::execute() const
     {
-        const RootsTable roots{m_arguments.degree};
-        Image img{m_arguments.width, m_arguments.height};
+        Renderer renderer;
 
-#ifdef RUN_ON_CPU
-        render_newton_cpu(m_arguments, roots, img);
-#else
-        render_newton_ispc(m_arguments, roots, img);
-#endif
+        if (!m_arguments.atlas.empty())
+        {
+            const int rows = atlas_rows(static_cast<int>(m_arguments.atlas.size()), m_arguments.atlasColumns);
+            const int atlas_width = m_arguments.width * m_arguments.atlasColumns;
+            Image atlas{atlas_width, m_arguments.height * rows, Image::padded_stride(atlas_width)};
+            render_atlas(renderer, m_arguments, m_arguments.atlas, m_arguments.atlasColumns, atlas);
+            return save(atlas);
+        }
+
+        Arguments arguments = m_arguments;
+        if (arguments.maxIterAuto)
+        {
+            const IterationChoice choice = IterationBudget::choose(renderer, arguments, arguments.maxIterCoverage);
+            arguments.maxIter = choice.maxIter;
+            std::cout << "max-iter auto: " << choice.maxIter << " (" << choice.coverage * 100.0 << "% of the converging pixels of a "
+                << choice.probeWidth << "x" << choice.probeHeight << " probe; " << choice.converging * 100.0 << "% of its pixels converge)"
+                << std::endl;
+        }
+
+        if (!arguments.stateOutPath.empty() || !arguments.resumePath.empty())
+        {
+            return execute_resumable(renderer, arguments);
+        }
+
+        Image img{arguments.width, arguments.height, Image::padded_stride(arguments.width)};
+        if (arguments.deadlineMs > 0)
+        {
+            const DeadlineReport report = DeadlineRenderer::render(renderer, arguments, std::chrono::milliseconds{arguments.deadlineMs}, img);
+            std::cout << "deadline " << arguments.deadlineMs << " ms: rendered " << report.width << "x" << report.height
+                << " at max-iter " << report.maxIter << " in " << report.elapsedMs << " ms (estimated full quality "
+                << report.estimatedMs << " ms" << (report.degraded ? ", degraded" : "") << (report.fellBack ? ", preview only" : "") << ")"
+                << std::endl;
+        }
+        else
+        {
+            renderer.render(arguments, img);
+        }
+        return save(img);
+    }
 
+    int Application::execute_resumable(Renderer& renderer, const Arguments& arguments) const
+    {
+        const std::size_t width = static_cast<std::size_t>(arguments.width);
+        RenderState state;
+        int resumeFrom = FieldSample::pending;
+        if (!arguments.resumePath.empty())
+        {
+            try
+            {
+                state = RenderState::load(arguments.resumePath);
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << std::endl;
+                return EXIT_FAILURE;
+            }
+            if (!state.resumable_by(arguments))
+            {
+                std::cerr << "Cannot resume from '" << arguments.resumePath << "': it holds a different view or polynomial, or a larger --max-iter"
+                    << std::endl;
+                return EXIT_FAILURE;
+            }
+            resumeFrom = state.max_iter();
+            std::cout << "resuming " << state.unconverged() << " of " << state.field().size() << " pixels from max-iter " << resumeFrom << std::endl;
+        }
+        else
+        {
+            state = RenderState{arguments, std::vector<FieldSample>(width * static_cast<std::size_t>(arguments.height))};
+        }
+
+        renderer.render_field(arguments, state.field().data(), width, resumeFrom);
+        Image img{arguments.width, arguments.height, Image::padded_stride(arguments.width)};
+        renderer.shade_field(arguments, PixelRect::frame(arguments), state.field().data(), width, img.view());
+
+        if (!arguments.stateOutPath.empty() && !RenderState{arguments, std::move(state.field())}.save(arguments.stateOutPath))
+        {
+            std::cerr << "Failed to write state file" << std::endl;
+            return EXIT_FAILURE;
+        }
+        return save(img);
+    }
+
+    int Application::save(const Image& img) const
+    {
         if (!img.save_png(m_arguments.outputPath))
         {
             std::cerr << "Failed to write PNG" << std::endl;
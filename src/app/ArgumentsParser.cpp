@@ -1,11 +1,177 @@
 #include "app/ArgumentsParser.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 
 #include <CLI11.hpp>
 
+#include "core/BigFloat.hpp"
+#include "core/Expression.hpp"
+#include "core/TileCertifier.hpp"
+
 namespace nfract
 {
+    namespace
+    {
+        /// Parses "a", "bi", "a+bi", "a-bi", "i" or "-i" (either part may use scientific notation, neither may be inf or
+        /// nan).
+        [[nodiscard]] std::complex<double> parse_complex(const std::string& text)
+        {
+            const auto fail = [&text]
+            {
+                return std::invalid_argument("Invalid complex coefficient: '" + text + "'");
+            };
+            const auto parse_real = [&fail](const std::string& part, const bool imaginary)
+            {
+                if (imaginary && (part.empty() || part == "+" || part == "-"))
+                {
+                    return part == "-" ? -1.0 : 1.0;
+                }
+                char* end = nullptr;
+                const double value = std::strtod(part.c_str(), &end);
+                if (part.empty() || end != part.c_str() + part.size() || !std::isfinite(value))
+                {
+                    throw fail();
+                }
+                return value;
+            };
+
+            if (text.empty())
+            {
+                throw fail();
+            }
+            if (text.back() != 'i')
+            {
+                return {parse_real(text, false), 0.0};
+            }
+
+            // Split "a+bi" at the last sign that is not part of an exponent
+            const std::string body = text.substr(0, text.size() - 1);
+            std::size_t split = std::string::npos;
+            for (std::size_t i = body.size(); i-- > 1;)
+            {
+                if ((body[i] == '+' || body[i] == '-') && body[i - 1] != 'e' && body[i - 1] != 'E')
+                {
+                    split = i;
+                    break;
+                }
+            }
+            if (split == std::string::npos)
+            {
+                return {0.0, parse_real(body, true)};
+            }
+            return {parse_real(body.substr(0, split), false), parse_real(body.substr(split), true)};
+        }
+
+        /// One complex root per token (whitespace or comma separated); '#' starts a comment running to end of line.
+        [[nodiscard]] std::vector<std::complex<double>> read_roots_file(const std::string& path)
+        {
+            std::ifstream file{path};
+            if (!file)
+            {
+                throw std::invalid_argument("Cannot open roots file: '" + path + "'");
+            }
+
+            std::vector<std::complex<double>> roots;
+            std::string line;
+            while (std::getline(file, line))
+            {
+                line = line.substr(0, line.find('#'));
+                std::ranges::replace(line, ',', ' ');
+
+                std::istringstream tokens{line};
+                std::string token;
+                while (tokens >> token)
+                {
+                    roots.push_back(parse_complex(token));
+                }
+            }
+
+            if (roots.empty())
+            {
+                throw std::invalid_argument("Roots file lists no roots: '" + path + "'");
+            }
+            return roots;
+        }
+
+        /// Comma separated degrees and inclusive ranges, e.g. "2-8,12,16"
+        [[nodiscard]] std::vector<int> parse_degree_list(const std::string& text)
+        {
+            const auto parse_degree = [&text](const std::string& part)
+            {
+                char* end = nullptr;
+                const long value = std::strtol(part.c_str(), &end, 10);
+                if (part.empty() || end != part.c_str() + part.size() || value < 2 || value > 64)
+                {
+                    throw std::invalid_argument("Invalid --atlas-degrees (degrees 2-64, e.g. 2-8,12): '" + text + "'");
+                }
+                return static_cast<int>(value);
+            };
+
+            if (text.empty() || text.back() == ',')
+            {
+                throw std::invalid_argument("Invalid --atlas-degrees (degrees 2-64, e.g. 2-8,12): '" + text + "'");
+            }
+
+            std::vector<int> degrees;
+            std::istringstream parts{text};
+            std::string part;
+            while (std::getline(parts, part, ','))
+            {
+                const std::size_t dash = part.find('-');
+                if (dash == std::string::npos)
+                {
+                    degrees.push_back(parse_degree(part));
+                    continue;
+                }
+                const int first = parse_degree(part.substr(0, dash));
+                const int last = parse_degree(part.substr(dash + 1));
+                if (first > last)
+                {
+                    throw std::invalid_argument("Invalid --atlas-degrees range: '" + part + "'");
+                }
+                for (int degree = first; degree <= last; ++degree)
+                {
+                    degrees.push_back(degree);
+                }
+            }
+            return degrees;
+        }
+
+        /// "xmin,xmax,ymin,ymax"
+        [[nodiscard]] std::array<float, 4> parse_viewport(const std::string& text)
+        {
+            std::array<float, 4> bounds{};
+            std::istringstream parts{text.ends_with(',') ? std::string{} : text};
+            std::string part;
+            std::size_t count = 0;
+            while (std::getline(parts, part, ','))
+            {
+                char* end = nullptr;
+                const float value = std::strtof(part.c_str(), &end);
+                if (count == bounds.size() || part.empty() || end != part.c_str() + part.size() || !std::isfinite(value))
+                {
+                    count = 0;
+                    break;
+                }
+                bounds[count++] = value;
+            }
+            if (count != bounds.size() || !(bounds[0] < bounds[1]) || !(bounds[2] < bounds[3]))
+            {
+                throw std::invalid_argument("Invalid --atlas-viewport (finite xmin,xmax,ymin,ymax with min < max): '" + text + "'");
+            }
+            return bounds;
+        }
+    }
+
     Arguments ArgumentsParser::parse(const std::span<const char* const>& args)
     {
         Arguments arguments;
@@ -31,29 +197,45 @@ namespace nfract
            ->check(CLI::PositiveNumber)
            ->default_val(arguments.height);
 
-        app.add_option("--xmin", arguments.xmin,
+        // Bounds are read as text so the deep-zoom kernels see every digit that was typed
+        std::string xmin_text = "-2";
+        std::string xmax_text = "2";
+        std::string ymin_text = "-2";
+        std::string ymax_text = "2";
+
+        app.add_option("--xmin", xmin_text,
                        "Minimum real value (left)")
-           ->default_val(arguments.xmin);
+           ->check(CLI::Number)
+           ->default_val(xmin_text);
 
-        app.add_option("--xmax", arguments.xmax,
+        app.add_option("--xmax", xmax_text,
                        "Maximum real value (right)")
-           ->default_val(arguments.xmax);
+           ->check(CLI::Number)
+           ->default_val(xmax_text);
 
-        app.add_option("--ymin", arguments.ymin,
+        app.add_option("--ymin", ymin_text,
                        "Minimum imaginary value (bottom)")
-           ->default_val(arguments.ymin);
+           ->check(CLI::Number)
+           ->default_val(ymin_text);
 
-        app.add_option("--ymax", arguments.ymax,
+        app.add_option("--ymax", ymax_text,
                        "Maximum imaginary value (top)")
-           ->default_val(arguments.ymax);
+           ->check(CLI::Number)
+           ->default_val(ymax_text);
+
+        std::string max_iter_text = std::to_string(arguments.maxIter);
+        app.add_option("--max-iter", max_iter_text,
+                       "Maximum number of Newton iterations, or auto to choose it from a low resolution probe")
+           ->check(CLI::IsMember({"auto"}) | CLI::Range(1, 10'000))
+           ->default_val(max_iter_text);
 
-        app.add_option("--max-iter", arguments.maxIter,
-                       "Maximum number of Newton iterations")
-           ->check(CLI::Range(1, 10'000))
-           ->default_val(arguments.maxIter);
+        auto* coverage_option = app.add_option("--auto-coverage", arguments.maxIterCoverage,
+                                               "With --max-iter auto, the share of converging probe pixels the budget must cover")
+                                   ->check(CLI::Range(0.5, 1.0))
+                                   ->default_val(arguments.maxIterCoverage);
 
         app.add_option("--tol", arguments.tolerance,
-                       "Convergence tolerance on |f(z)|")
+                       "Convergence tolerance on |f(z)| for z^n - 1, on degree |f(z) / f'(z)| for other polynomials")
            ->check(CLI::Range(1e-6, 1e-2))
            ->default_val(arguments.tolerance);
 
@@ -61,12 +243,117 @@ namespace nfract
                        "Output PNG file path")
            ->default_val(arguments.outputPath);
 
+        std::vector<std::string> coefficient_texts;
+        app.add_option("--coeffs", coefficient_texts,
+                       "Render an arbitrary polynomial: complex coefficients, highest degree first (e.g. 1,0,-2+1i,0.5i)")
+           ->delimiter(',')
+           ->expected(2, CLI::detail::expected_max_vector_size);
+
+        std::string roots_path;
+        app.add_option("--roots-file", roots_path,
+                       "Render the polynomial with the roots listed in this file (complex numbers like 0.5-1i, one per token)")
+           ->check(CLI::ExistingFile)
+           ->excludes("--coeffs");
+
+        std::string expression_text;
+        app.add_option("--expr", expression_text,
+                       "Render a polynomial typed as an expression in z (e.g. \"z^7 + 3z^2 - 1\"), run by a bytecode interpreter")
+           ->excludes("--coeffs")
+           ->excludes("--roots-file");
+
+        std::string family_text;
+        app.add_option("--family", family_text,
+                       "Render the parameter plane of a family affine in a (e.g. \"z^3 + (a-1)z - a\"): each pixel is a value of a")
+           ->excludes("--coeffs")
+           ->excludes("--roots-file")
+           ->excludes("--expr");
+
+        const std::map<std::string, Precision> precision_names{
+            {"single", Precision::SINGLE},
+            {"double-double", Precision::DOUBLE_DOUBLE},
+            {"perturbation", Precision::PERTURBATION},
+        };
+        app.add_option("--precision", arguments.precision,
+                       "Arithmetic used by the Newton iteration (double-double below ~1e-6 spans, perturbation below ~1e-28)")
+           ->transform(CLI::CheckedTransformer(precision_names, CLI::ignore_case))
+           ->default_str("single");
+
+        const std::map<std::string, Method> method_names{
+            {"newton", Method::NEWTON},
+            {"halley", Method::HALLEY},
+            {"householder3", Method::HOUSEHOLDER3},
+            {"schroder", Method::SCHRODER},
+        };
+        app.add_option("--method", arguments.method,
+                       "Root-finding iteration: newton, halley (cubic), householder3 (quartic) or schroder (multiple roots)")
+           ->transform(CLI::CheckedTransformer(method_names, CLI::ignore_case))
+           ->default_str("newton");
+
+        std::string atlas_degrees;
+        app.add_option("--atlas-degrees", atlas_degrees,
+                       "Render a contact sheet of z^n - 1 for these degrees (e.g. 2-64 or 3,5,7), --width x --height per cell")
+           ->excludes("--coeffs")
+           ->excludes("--roots-file")
+           ->excludes("--expr")
+           ->excludes("--family");
+
+        const std::map<std::string, ColorMode> palette_names{
+            {"classic", ColorMode::CLASSIC},
+            {"neon", ColorMode::NEON},
+            {"jewelry", ColorMode::JEWELRY},
+            {"equalized", ColorMode::EQUALIZED},
+        };
+        std::vector<ColorMode> atlas_palettes;
+        app.add_option("--atlas-palettes", atlas_palettes,
+                       "Palettes of each atlas row: classic, neon, jewelry, equalized (default: the selected palette)")
+           ->delimiter(',')
+           ->transform(CLI::CheckedTransformer(palette_names, CLI::ignore_case))
+           ->needs("--atlas-degrees");
+
+        std::vector<std::string> atlas_viewports;
+        app.add_option("--atlas-viewport", atlas_viewports,
+                       "Bounds xmin,xmax,ymin,ymax of one more atlas column group, repeatable (default: --xmin .. --ymax)")
+           ->expected(1)
+           ->multi_option_policy(CLI::MultiOptionPolicy::TakeAll)
+           ->needs("--atlas-degrees");
+
+        app.add_option("--atlas-columns", arguments.atlasColumns,
+                       "Cells per atlas row (default: one row per degree)")
+           ->check(CLI::PositiveNumber)
+           ->needs("--atlas-degrees");
+
+        app.add_flag("--certify-tiles", arguments.certifyTiles,
+                     "Prove whole tiles converge to one root with interval Newton steps and fill them without per-pixel work");
+
+        app.add_option("--deadline-ms", arguments.deadlineMs,
+                       "Finish within this many milliseconds, lowering resolution and then max-iter if the estimate says so")
+           ->check(CLI::Range(1, 3'600'000))
+           ->excludes("--atlas-degrees");
+
+        app.add_option("--state-out", arguments.stateOutPath,
+                       "Also save the iteration state, so a later render with a larger --max-iter can --resume from it")
+           ->excludes("--atlas-degrees")
+           ->excludes("--deadline-ms")
+           ->excludes("--certify-tiles");
+        app.add_option("--resume", arguments.resumePath,
+                       "Continue the pixels that ran out of iterations in this --state-out file, up to --max-iter")
+           ->excludes("--atlas-degrees")
+           ->excludes("--deadline-ms")
+           ->excludes("--certify-tiles");
+
         bool use_neon = false;
         bool use_jewelry = false;
+        bool use_equalized = false;
         auto* neon_flag = app.add_flag("--neon", use_neon, "Render using the neon color palette");
         auto* jewelry_flag = app.add_flag("--jewelry", use_jewelry, "Render using the jewelry color palette");
+        auto* equalized_flag = app.add_flag("--equalized", use_equalized,
+                                            "Render with brightness by the rank of each pixel's iteration count in the frame (histogram equalization)");
+        app.add_flag("--fast-math-shading", arguments.fastShading,
+                     "Shade neon and jewelry with polynomial log2 and cos, within one step per channel of the exact palettes. "
+                     "Faster in ISPC builds; in CPU-only builds the shading is 10-30% slower, except when re-shading a kept field in neon");
         neon_flag->excludes(jewelry_flag);
         jewelry_flag->excludes(neon_flag);
+        equalized_flag->excludes(neon_flag)->excludes(jewelry_flag);
 
         try
         {
@@ -77,15 +364,144 @@ namespace nfract
             std::exit(app.exit(e));
         }
 
-        if (arguments.xmin >= arguments.xmax)
+        // Compare at full typed precision: perturbation bounds can agree in far more digits than a double holds
+        const int limbs = static_cast<int>(std::max({xmin_text.size(), xmax_text.size(), ymin_text.size(), ymax_text.size()}) / 9 + 2);
+        const BigFloat xmin = BigFloat::parse(xmin_text, limbs);
+        const BigFloat xmax = BigFloat::parse(xmax_text, limbs);
+        const BigFloat ymin = BigFloat::parse(ymin_text, limbs);
+        const BigFloat ymax = BigFloat::parse(ymax_text, limbs);
+
+        if (max_iter_text == "auto")
+        {
+            arguments.maxIterAuto = true;
+        }
+        else
+        {
+            arguments.maxIter = std::stoi(max_iter_text);
+            if (coverage_option->count() > 0)
+            {
+                throw std::invalid_argument("--auto-coverage needs --max-iter auto");
+            }
+        }
+
+        if (!(xmin < xmax))
         {
             throw std::invalid_argument("xmin must be < xmax");
         }
-        if (arguments.ymin >= arguments.ymax)
+        if (!(ymin < ymax))
         {
             throw std::invalid_argument("ymin must be < ymax");
         }
 
+        arguments.xmin = static_cast<float>(xmin.to_double());
+        arguments.xmax = static_cast<float>(xmax.to_double());
+        arguments.ymin = static_cast<float>(ymin.to_double());
+        arguments.ymax = static_cast<float>(ymax.to_double());
+
+        // Every precision keeps the float bounds (single precision renders from them, caches and state files key on
+        // them), so a bound beyond float range would turn into infinity
+        if (!std::isfinite(arguments.xmin) || !std::isfinite(arguments.xmax) || !std::isfinite(arguments.ymin) || !std::isfinite(arguments.ymax))
+        {
+            throw std::invalid_argument("Bounds must be finite and within float range");
+        }
+
+        arguments.xminDecimal = std::move(xmin_text);
+        arguments.xmaxDecimal = std::move(xmax_text);
+        arguments.yminDecimal = std::move(ymin_text);
+        arguments.ymaxDecimal = std::move(ymax_text);
+
+        // Single precision renders use the float bounds, which can meet where the typed ones do not
+        if (arguments.precision == Precision::SINGLE && !(arguments.xmin < arguments.xmax))
+        {
+            throw std::invalid_argument("xmin must be < xmax in single precision; use --precision double-double or perturbation for a view this narrow");
+        }
+        if (arguments.precision == Precision::SINGLE && !(arguments.ymin < arguments.ymax))
+        {
+            throw std::invalid_argument("ymin must be < ymax in single precision; use --precision double-double or perturbation for a view this narrow");
+        }
+
+        // Perturbation pixels are double offsets of whole pixel steps from the reference, which lose precision once the
+        // step is subnormal and vanish below about 1e-324
+        if (arguments.precision == Precision::PERTURBATION)
+        {
+            const double dx = ((xmax - xmin) / BigFloat{static_cast<double>(std::max(1, arguments.width - 1)), limbs}).to_double();
+            const double dy = ((ymax - ymin) / BigFloat{static_cast<double>(std::max(1, arguments.height - 1)), limbs}).to_double();
+            if (!std::isnormal(dx) || !std::isnormal(dy))
+            {
+                throw std::invalid_argument("View too narrow for --precision perturbation: the span per pixel must be at least about 1e-308");
+            }
+        }
+
+        if (arguments.method != Method::NEWTON && arguments.precision != Precision::SINGLE)
+        {
+            throw std::invalid_argument("--method other than newton is only supported with single precision");
+        }
+
+        if (!coefficient_texts.empty())
+        {
+            if (arguments.precision != Precision::SINGLE)
+            {
+                throw std::invalid_argument("--coeffs is only supported with single precision");
+            }
+            arguments.form = PolynomialForm::COEFFICIENTS;
+            arguments.coefficients.clear();
+            for (const auto& text : coefficient_texts)
+            {
+                arguments.coefficients.push_back(parse_complex(text));
+            }
+            if (std::ranges::all_of(arguments.coefficients.begin(), arguments.coefficients.end() - 1, [](const auto& c) { return c == 0.0; }))
+            {
+                throw std::invalid_argument("--coeffs must describe a polynomial of degree >= 1");
+            }
+        }
+
+        if (!roots_path.empty())
+        {
+            if (arguments.precision != Precision::SINGLE)
+            {
+                throw std::invalid_argument("--roots-file is only supported with single precision");
+            }
+            arguments.form = PolynomialForm::ROOTS;
+            arguments.roots = read_roots_file(roots_path);
+        }
+
+        if (!expression_text.empty())
+        {
+            if (arguments.precision != Precision::SINGLE)
+            {
+                throw std::invalid_argument("--expr is only supported with single precision");
+            }
+            const Expression expression = Expression::parse(expression_text);
+            if (expression.has_parameter())
+            {
+                throw std::invalid_argument("--expr cannot use the parameter a, see --family");
+            }
+            arguments.form = PolynomialForm::EXPRESSION;
+            arguments.coefficients.assign(expression.coefficients().begin(), expression.coefficients().end());
+            arguments.expression = std::move(expression_text);
+        }
+
+        if (!family_text.empty())
+        {
+            if (arguments.precision != Precision::SINGLE || arguments.method != Method::NEWTON)
+            {
+                throw std::invalid_argument("--family is only supported with single precision and --method newton");
+            }
+            const Expression family = Expression::parse(family_text);
+            if (!family.has_parameter())
+            {
+                throw std::invalid_argument("--family must use the parameter a");
+            }
+            const std::size_t degree = family.coefficients().size() - 1;
+            if (degree != 3 && degree != 4)
+            {
+                throw std::invalid_argument("--family must be a cubic or quartic in z");
+            }
+            arguments.form = PolynomialForm::FAMILY;
+            arguments.coefficients.assign(family.coefficients().begin(), family.coefficients().end());
+            arguments.parameterCoefficients.assign(family.parameter_coefficients().begin(), family.parameter_coefficients().end());
+        }
+
         if (use_jewelry)
         {
             arguments.colorMode = ColorMode::JEWELRY;
@@ -94,6 +510,78 @@ namespace nfract
         {
             arguments.colorMode = ColorMode::NEON;
         }
+        else if (use_equalized)
+        {
+            arguments.colorMode = ColorMode::EQUALIZED;
+        }
+
+        if (!atlas_degrees.empty())
+        {
+            if (arguments.precision != Precision::SINGLE)
+            {
+                throw std::invalid_argument("--atlas-degrees is only supported with single precision");
+            }
+            if (arguments.maxIterAuto)
+            {
+                throw std::invalid_argument("--max-iter auto is not supported with --atlas-degrees");
+            }
+            std::vector<std::array<float, 4>> viewports;
+            for (const auto& text : atlas_viewports)
+            {
+                viewports.push_back(parse_viewport(text));
+            }
+            if (viewports.empty())
+            {
+                viewports.push_back({arguments.xmin, arguments.xmax, arguments.ymin, arguments.ymax});
+            }
+            if (atlas_palettes.empty())
+            {
+                atlas_palettes.push_back(arguments.colorMode);
+            }
+
+            // Degree-major, so with the default column count every row is one degree
+            for (const int degree : parse_degree_list(atlas_degrees))
+            {
+                for (const auto& [xmin_cell, xmax_cell, ymin_cell, ymax_cell] : viewports)
+                {
+                    for (const ColorMode palette : atlas_palettes)
+                    {
+                        arguments.atlas.push_back({degree, xmin_cell, xmax_cell, ymin_cell, ymax_cell, palette});
+                    }
+                }
+            }
+            if (arguments.atlasColumns == 0)
+            {
+                arguments.atlasColumns = static_cast<int>(viewports.size() * atlas_palettes.size());
+            }
+        }
+
+        // Only these renders have certified tiles (see core/TileCertifier.hpp); anywhere else the flag would do nothing
+        if (arguments.certifyTiles)
+        {
+            if (arguments.precision != Precision::SINGLE || arguments.method != Method::NEWTON)
+            {
+                throw std::invalid_argument("--certify-tiles is only supported with single precision and --method newton");
+            }
+            if (arguments.form != PolynomialForm::UNITY && arguments.form != PolynomialForm::COEFFICIENTS)
+            {
+                throw std::invalid_argument("--certify-tiles is only supported for z^n - 1 and --coeffs");
+            }
+            if (arguments.form == PolynomialForm::COEFFICIENTS)
+            {
+                const auto leading = std::ranges::find_if(arguments.coefficients, [](const auto& c) { return c != 0.0; });
+                if (std::distance(leading, arguments.coefficients.end()) - 1 > TileCertifier::max_degree)
+                {
+                    throw std::invalid_argument("--certify-tiles supports --coeffs up to degree " + std::to_string(TileCertifier::max_degree));
+                }
+            }
+            const bool classic = arguments.colorMode == ColorMode::CLASSIC
+                                 && std::ranges::all_of(arguments.atlas, [](const AtlasCell& cell) { return cell.colorMode == ColorMode::CLASSIC; });
+            if (!classic)
+            {
+                throw std::invalid_argument("--certify-tiles is only supported with the classic palette");
+            }
+        }
 
         return arguments;
     }
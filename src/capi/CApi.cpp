@@ -0,0 +1,179 @@
+#include "capi/nfract.h"
+
+#include <cmath>
+#include <exception>
+#include <new>
+#include <stdexcept>
+
+#include "core/Renderer.hpp"
+#include "core/RenderParams.hpp"
+
+struct nfract_renderer
+{
+    explicit nfract_renderer(const int threads) :
+        renderer(threads)
+    {
+    }
+
+    nfract::Renderer renderer;
+};
+
+namespace
+{
+    [[nodiscard]] std::vector<std::complex<double>> complex_pairs(const double* values, const int count)
+    {
+        std::vector<std::complex<double>> result;
+        result.reserve(static_cast<std::size_t>(count));
+        for (int i = 0; i < count; ++i)
+        {
+            if (!std::isfinite(values[2 * i]) || !std::isfinite(values[2 * i + 1]))
+            {
+                throw std::invalid_argument("nfract_params coefficients and roots must be finite");
+            }
+            result.emplace_back(values[2 * i], values[2 * i + 1]);
+        }
+        return result;
+    }
+
+    /// Mirrors the checks ArgumentsParser makes on the command line
+    [[nodiscard]] nfract::RenderParams to_render_params(const nfract_params& in)
+    {
+        // Written so that NaN fails every range
+        const bool bounds = std::isfinite(in.xmin) && std::isfinite(in.xmax) && std::isfinite(in.ymin) && std::isfinite(in.ymax)
+                            && in.xmin < in.xmax && in.ymin < in.ymax;
+        if (in.width <= 0 || in.height <= 0 || in.max_iter < 1 || in.max_iter > 10'000 || !(in.tolerance >= 1e-6f && in.tolerance <= 1e-2f) || !bounds
+            || in.color_mode < NFRACT_COLOR_JEWELRY || in.color_mode > NFRACT_COLOR_EQUALIZED
+            || in.method < NFRACT_METHOD_NEWTON || in.method > NFRACT_METHOD_SCHRODER
+            || in.num_coefficients < 0 || in.num_roots < 0)
+        {
+            throw std::invalid_argument("invalid nfract_params");
+        }
+
+        nfract::RenderParams p;
+        p.degree = in.degree;
+        p.width = in.width;
+        p.height = in.height;
+        p.maxIter = in.max_iter;
+        p.xmin = in.xmin;
+        p.xmax = in.xmax;
+        p.ymin = in.ymin;
+        p.ymax = in.ymax;
+        p.tolerance = in.tolerance;
+        p.colorMode = static_cast<nfract::ColorMode>(in.color_mode);
+        p.method = static_cast<nfract::Method>(in.method);
+
+        if (in.expression != nullptr)
+        {
+            p.form = nfract::PolynomialForm::EXPRESSION;
+            p.expression = in.expression;
+            const nfract::Expression expression = nfract::Expression::parse(p.expression);
+            if (expression.has_parameter())
+            {
+                throw std::invalid_argument("nfract_params.expression cannot use the parameter a");
+            }
+            p.coefficients.assign(expression.coefficients().begin(), expression.coefficients().end());
+        }
+        else if (in.coefficients != nullptr && in.num_coefficients > 0)
+        {
+            p.form = nfract::PolynomialForm::COEFFICIENTS;
+            p.coefficients = complex_pairs(in.coefficients, in.num_coefficients);
+        }
+        else if (in.roots != nullptr && in.num_roots > 0)
+        {
+            p.form = nfract::PolynomialForm::ROOTS;
+            p.roots = complex_pairs(in.roots, in.num_roots);
+        }
+        else if (in.degree < 2 || in.degree > 64)
+        {
+            throw std::invalid_argument("nfract_params.degree must be in [2, 64]");
+        }
+        return p;
+    }
+
+    [[nodiscard]] int render(nfract::Renderer& renderer, const nfract_params* params, std::uint8_t* out, const std::size_t stride) noexcept
+    {
+        if (params == nullptr || out == nullptr)
+        {
+            return NFRACT_ERROR_INVALID_ARGUMENT;
+        }
+        try
+        {
+            const nfract::RenderParams p = to_render_params(*params);
+            if (stride < static_cast<std::size_t>(p.width) * 4u)
+            {
+                return NFRACT_ERROR_INVALID_ARGUMENT;
+            }
+            renderer.render(p, out, stride);
+            return NFRACT_OK;
+        }
+        catch (const std::invalid_argument&)
+        {
+            return NFRACT_ERROR_INVALID_ARGUMENT;
+        }
+        catch (...)
+        {
+            return NFRACT_ERROR_INTERNAL;
+        }
+    }
+}
+
+extern "C"
+{
+    void nfract_params_init(nfract_params* params)
+    {
+        if (params == nullptr)
+        {
+            return;
+        }
+        const nfract::RenderParams defaults;
+        *params = nfract_params{};
+        params->degree = defaults.degree;
+        params->width = defaults.width;
+        params->height = defaults.height;
+        params->max_iter = defaults.maxIter;
+        params->xmin = defaults.xmin;
+        params->xmax = defaults.xmax;
+        params->ymin = defaults.ymin;
+        params->ymax = defaults.ymax;
+        params->tolerance = defaults.tolerance;
+        params->color_mode = static_cast<int>(defaults.colorMode);
+        params->method = static_cast<int>(defaults.method);
+    }
+
+    int nfract_render(const nfract_params* params, uint8_t* out, const size_t stride)
+    {
+        static nfract::Renderer renderer;
+        return render(renderer, params, out, stride);
+    }
+
+    nfract_renderer* nfract_renderer_create(const int threads)
+    {
+        try
+        {
+            return new nfract_renderer{threads};
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    void nfract_renderer_destroy(nfract_renderer* renderer)
+    {
+        delete renderer;
+    }
+
+    int nfract_renderer_render(nfract_renderer* renderer, const nfract_params* params, uint8_t* out, const size_t stride)
+    {
+        if (renderer == nullptr)
+        {
+            return NFRACT_ERROR_INVALID_ARGUMENT;
+        }
+        return render(renderer->renderer, params, out, stride);
+    }
+
+    const char* nfract_version(void)
+    {
+        return PROJECT_VERSION;
+    }
+}
@@ -0,0 +1,53 @@
+#include "core/Atlas.hpp"
+
+#include <map>
+
+namespace nfract
+{
+    int atlas_rows(const int cells, const int columns) noexcept
+    {
+        return columns > 0 ? (cells + columns - 1) / columns : 0;
+    }
+
+    void render_atlas(Renderer& renderer, const RenderParams& base, const std::span<const AtlasCell> cells, const int columns, Image& atlas)
+    {
+        const int count = static_cast<int>(cells.size());
+        if (cells.empty() || base.width <= 0 || base.height <= 0 || columns <= 0
+            || atlas.width() != base.width * columns || atlas.height() != base.height * atlas_rows(count, columns))
+        {
+            return;
+        }
+
+        RenderParams unity = base;
+        unity.form = PolynomialForm::UNITY;
+
+        // Read-only once the tiles start
+        std::map<int, PreparedPolynomial> prepared;
+        for (const AtlasCell& cell : cells)
+        {
+            if (!prepared.contains(cell.degree))
+            {
+                unity.degree = cell.degree;
+                prepared.emplace(cell.degree, PreparedPolynomial::prepare(unity));
+            }
+        }
+
+        const ImageView frame = atlas.view();
+        renderer.pool().parallel_for(count, [&](const int index)
+        {
+            const AtlasCell& cell = cells[static_cast<std::size_t>(index)];
+
+            RenderParams params = unity;
+            params.degree = cell.degree;
+            params.xmin = cell.xmin;
+            params.xmax = cell.xmax;
+            params.ymin = cell.ymin;
+            params.ymax = cell.ymax;
+            params.colorMode = cell.colorMode;
+
+            const int x0 = (index % columns) * base.width;
+            const int y0 = (index / columns) * base.height;
+            renderer.render(params, prepared.at(cell.degree), frame.sub(x0, y0, base.width, base.height));
+        });
+    }
+}
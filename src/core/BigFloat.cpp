@@ -0,0 +1,319 @@
+#include "core/BigFloat.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+#include "core/DecimalLiteral.hpp"
+
+namespace nfract
+{
+    namespace
+    {
+        constexpr int limb_bits = 32;
+        constexpr int min_limbs = 2;
+
+        /// 32 bits of the little-endian integer `limbs` starting at bit `pos` (bits outside the integer read as 0).
+        [[nodiscard]] BigFloat::limb_type extract_bits(const std::vector<BigFloat::limb_type>& limbs, const std::int64_t pos) noexcept
+        {
+            const std::int64_t index = pos >= 0 ? pos / limb_bits : -((-pos + limb_bits - 1) / limb_bits);
+            const int offset = static_cast<int>(pos - index * limb_bits);
+            const auto limb_at = [&limbs](const std::int64_t i) -> std::uint64_t
+            {
+                return i >= 0 && i < static_cast<std::int64_t>(limbs.size()) ? limbs[static_cast<std::size_t>(i)] : 0u;
+            };
+
+            const std::uint64_t pair = limb_at(index) | (limb_at(index + 1) << limb_bits);
+            return static_cast<BigFloat::limb_type>(pair >> offset);
+        }
+
+        [[nodiscard]] std::int64_t highest_bit(const std::vector<BigFloat::limb_type>& limbs) noexcept
+        {
+            for (std::size_t i = limbs.size(); i-- > 0;)
+            {
+                if (limbs[i] != 0)
+                {
+                    return static_cast<std::int64_t>(i) * limb_bits + (limb_bits - 1 - std::countl_zero(limbs[i]));
+                }
+            }
+            return -1;
+        }
+    }
+
+    BigFloat::BigFloat(const int limbs) :
+        m_mantissa(static_cast<std::size_t>(std::max(limbs, min_limbs)), 0u)
+    {
+    }
+
+    BigFloat::BigFloat(const double value, const int limbs) :
+        BigFloat(limbs)
+    {
+        if (value == 0.0 || !std::isfinite(value))
+        {
+            return;
+        }
+
+        int exponent = 0;
+        const double fraction = std::frexp(std::abs(value), &exponent);
+        const auto bits = static_cast<std::uint64_t>(std::ldexp(fraction, 53));
+
+        std::vector<limb_type> wide{static_cast<limb_type>(bits), static_cast<limb_type>(bits >> limb_bits)};
+        m_negative = value < 0.0;
+        normalize(wide, exponent - 53);
+    }
+
+    BigFloat BigFloat::parse(const std::string_view text, const int limbs)
+    {
+        const DecimalLiteral literal = DecimalLiteral::parse(text);
+
+        const BigFloat ten{10.0, limbs};
+        BigFloat mantissa{limbs};
+        for (const char c : literal.digits)
+        {
+            mantissa = mantissa * ten + BigFloat{static_cast<double>(c - '0'), limbs};
+        }
+
+        BigFloat scale{1.0, limbs};
+        BigFloat base = ten;
+        for (int e = std::abs(literal.exponent); e > 0; e >>= 1)
+        {
+            if (e & 1)
+            {
+                scale = scale * base;
+            }
+            base = base * base;
+        }
+
+        BigFloat value = literal.exponent >= 0 ? mantissa * scale : mantissa / scale;
+        value.m_negative = literal.negative && !value.is_zero();
+        return value;
+    }
+
+    int BigFloat::limbs() const noexcept
+    {
+        return static_cast<int>(m_mantissa.size());
+    }
+
+    bool BigFloat::is_zero() const noexcept
+    {
+        return std::ranges::all_of(m_mantissa, [](const limb_type l) { return l == 0; });
+    }
+
+    bool BigFloat::negative() const noexcept
+    {
+        return m_negative;
+    }
+
+    double BigFloat::to_double() const noexcept
+    {
+        if (is_zero())
+        {
+            return 0.0;
+        }
+
+        const std::size_t n = m_mantissa.size();
+        const std::uint64_t top = (static_cast<std::uint64_t>(m_mantissa[n - 1]) << limb_bits) | m_mantissa[n - 2];
+        const std::int64_t exponent = m_exponent + static_cast<std::int64_t>(n - 2) * limb_bits;
+        const int clamped = static_cast<int>(std::clamp<std::int64_t>(exponent, -4000, 4000));
+        const double magnitude = std::ldexp(static_cast<double>(top), clamped);
+        return m_negative ? -magnitude : magnitude;
+    }
+
+    BigFloat BigFloat::reciprocal() const
+    {
+        if (is_zero())
+        {
+            throw std::domain_error("BigFloat reciprocal of zero");
+        }
+
+        const int n = limbs();
+        const std::uint64_t top = (static_cast<std::uint64_t>(m_mantissa[static_cast<std::size_t>(n - 1)]) << limb_bits) | m_mantissa[static_cast<std::size_t>(n - 2)];
+
+        // Seed from the leading 64 bits (mantissa in [0.5, 1)), then Newton x <- x + x (1 - a x) doubles the
+        // number of correct bits per step, starting from the ~50 a double gives us.
+        BigFloat x{1.0 / std::ldexp(static_cast<double>(top), -64), n};
+        x.m_negative = m_negative;
+        x.m_exponent -= m_exponent + static_cast<std::int64_t>(n) * limb_bits;
+
+        const BigFloat one{1.0, n};
+        for (int bits = 50; bits < 2 * n * limb_bits; bits *= 2)
+        {
+            x = x + x * (one - *this * x);
+        }
+        return x;
+    }
+
+    BigFloat operator+(const BigFloat& a, const BigFloat& b)
+    {
+        return BigFloat::add_magnitudes(a, b, a.m_negative != b.m_negative);
+    }
+
+    BigFloat operator-(const BigFloat& a, const BigFloat& b)
+    {
+        return a + (-b);
+    }
+
+    BigFloat operator-(const BigFloat& a)
+    {
+        BigFloat r = a;
+        r.m_negative = !a.m_negative && !a.is_zero();
+        return r;
+    }
+
+    BigFloat operator*(const BigFloat& a, const BigFloat& b)
+    {
+        const int n = std::max(a.limbs(), b.limbs());
+        if (a.is_zero() || b.is_zero())
+        {
+            return BigFloat{n};
+        }
+
+        const BigFloat lhs = a.with_limbs(n);
+        const BigFloat rhs = b.with_limbs(n);
+        const auto un = static_cast<std::size_t>(n);
+
+        std::vector<BigFloat::limb_type> wide(2 * un, 0u);
+        for (std::size_t i = 0; i < un; ++i)
+        {
+            std::uint64_t carry = 0;
+            const std::uint64_t ai = lhs.m_mantissa[i];
+            for (std::size_t j = 0; j < un; ++j)
+            {
+                const std::uint64_t cur = wide[i + j] + ai * rhs.m_mantissa[j] + carry;
+                wide[i + j] = static_cast<BigFloat::limb_type>(cur);
+                carry = cur >> limb_bits;
+            }
+            wide[i + un] = static_cast<BigFloat::limb_type>(carry);
+        }
+
+        BigFloat r{n};
+        r.m_negative = a.m_negative != b.m_negative;
+        r.normalize(wide, lhs.m_exponent + rhs.m_exponent);
+        return r;
+    }
+
+    BigFloat operator/(const BigFloat& a, const BigFloat& b)
+    {
+        const int n = std::max(a.limbs(), b.limbs());
+        return a.with_limbs(n) * b.with_limbs(n).reciprocal();
+    }
+
+    bool operator<(const BigFloat& a, const BigFloat& b) noexcept
+    {
+        const bool a_neg = a.m_negative && !a.is_zero();
+        const bool b_neg = b.m_negative && !b.is_zero();
+        if (a_neg != b_neg)
+        {
+            return a_neg;
+        }
+        const int cmp = BigFloat::compare_magnitude(a, b);
+        return a_neg ? cmp > 0 : cmp < 0;
+    }
+
+    int BigFloat::compare_magnitude(const BigFloat& a, const BigFloat& b) noexcept
+    {
+        const bool a_zero = a.is_zero();
+        const bool b_zero = b.is_zero();
+        if (a_zero || b_zero)
+        {
+            return a_zero == b_zero ? 0 : (a_zero ? -1 : 1);
+        }
+
+        // Both are normalized, so the top bit position decides unless it ties
+        const std::int64_t ta = a.m_exponent + static_cast<std::int64_t>(a.limbs()) * limb_bits;
+        const std::int64_t tb = b.m_exponent + static_cast<std::int64_t>(b.limbs()) * limb_bits;
+        if (ta != tb)
+        {
+            return ta < tb ? -1 : 1;
+        }
+
+        const int n = std::max(a.limbs(), b.limbs());
+        for (int i = n - 1; i >= 0; --i)
+        {
+            const auto la = extract_bits(a.m_mantissa, static_cast<std::int64_t>(i - n + a.limbs()) * limb_bits);
+            const auto lb = extract_bits(b.m_mantissa, static_cast<std::int64_t>(i - n + b.limbs()) * limb_bits);
+            if (la != lb)
+            {
+                return la < lb ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    BigFloat BigFloat::add_magnitudes(const BigFloat& a, const BigFloat& b, const bool subtract)
+    {
+        const int n = std::max(a.limbs(), b.limbs());
+        const bool swap = compare_magnitude(a, b) < 0;
+        const BigFloat big = (swap ? b : a).with_limbs(n);
+        const BigFloat small = (swap ? a : b).with_limbs(n);
+
+        if (small.is_zero())
+        {
+            return big;
+        }
+
+        // One guard limb below the larger operand and one carry limb above it
+        const auto un = static_cast<std::size_t>(n);
+        const std::int64_t shift = big.m_exponent - small.m_exponent;
+        std::vector<limb_type> wide(un + 2, 0u);
+        std::vector<limb_type> addend(un + 2, 0u);
+        for (std::size_t i = 0; i < un; ++i)
+        {
+            wide[i + 1] = big.m_mantissa[i];
+        }
+        for (std::size_t i = 0; i <= un; ++i)
+        {
+            addend[i] = extract_bits(small.m_mantissa, static_cast<std::int64_t>(i) * limb_bits + shift - limb_bits);
+        }
+
+        std::int64_t carry = 0;
+        for (std::size_t i = 0; i < wide.size(); ++i)
+        {
+            const std::int64_t cur = static_cast<std::int64_t>(wide[i]) + (subtract ? -static_cast<std::int64_t>(addend[i]) : static_cast<std::int64_t>(addend[i])) + carry;
+            wide[i] = static_cast<limb_type>(cur);
+            carry = cur >> limb_bits;
+        }
+
+        // The sum takes the sign of the operand with the larger magnitude
+        BigFloat r{n};
+        r.m_negative = big.m_negative;
+        r.normalize(wide, big.m_exponent - limb_bits);
+        r.m_negative = r.m_negative && !r.is_zero();
+        return r;
+    }
+
+    BigFloat BigFloat::with_limbs(const int limbs) const
+    {
+        if (limbs == this->limbs())
+        {
+            return *this;
+        }
+
+        BigFloat r{limbs};
+        r.m_negative = m_negative;
+        std::vector<limb_type> wide = m_mantissa;
+        r.normalize(wide, m_exponent);
+        return r;
+    }
+
+    void BigFloat::normalize(std::vector<limb_type>& wide, const std::int64_t exponent)
+    {
+        const std::size_t n = m_mantissa.size();
+        const std::int64_t top = highest_bit(wide);
+        if (top < 0)
+        {
+            std::ranges::fill(m_mantissa, 0u);
+            m_exponent = 0;
+            return;
+        }
+
+        // Move the highest set bit to the top of the mantissa, truncating whatever falls off the bottom
+        const std::int64_t shift = top - (static_cast<std::int64_t>(n) * limb_bits - 1);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            m_mantissa[i] = extract_bits(wide, static_cast<std::int64_t>(i) * limb_bits + shift);
+        }
+        m_exponent = exponent + shift;
+    }
+}
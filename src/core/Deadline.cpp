@@ -0,0 +1,135 @@
+#include "core/Deadline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace nfract
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        [[nodiscard]] double ms_since(const Clock::time_point start) noexcept
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        /// p at another resolution over the same viewport (pixel centres on the same corners)
+        [[nodiscard]] RenderParams resized(const RenderParams& p, const int width, const int height)
+        {
+            RenderParams q = p;
+            q.width = std::max(1, width);
+            q.height = std::max(1, height);
+            return q;
+        }
+
+        /// Nearest neighbour from `src` onto `dst`, both covering the same viewport with corner pixels on its corners
+        void upscale_nearest(const Image& src, Image& dst) noexcept
+        {
+            const int sw = src.width();
+            const int sh = src.height();
+            const int dw = dst.width();
+            const int dh = dst.height();
+            const float fx = dw > 1 ? static_cast<float>(sw - 1) / static_cast<float>(dw - 1) : 0.0f;
+            const float fy = dh > 1 ? static_cast<float>(sh - 1) / static_cast<float>(dh - 1) : 0.0f;
+
+            for (int y = 0; y < dh; ++y)
+            {
+                const int sy = std::min(sh - 1, static_cast<int>(static_cast<float>(y) * fy + 0.5f));
+                const std::uint8_t* src_row = src.data() + static_cast<std::size_t>(sy) * src.stride();
+                std::uint8_t* dst_row = dst.data() + static_cast<std::size_t>(y) * dst.stride();
+                for (int x = 0; x < dw; ++x)
+                {
+                    const int sx = std::min(sw - 1, static_cast<int>(static_cast<float>(x) * fx + 0.5f));
+                    std::memcpy(dst_row + static_cast<std::size_t>(x) * 4u, src_row + static_cast<std::size_t>(sx) * 4u, 4u);
+                }
+            }
+        }
+    }
+
+    DeadlineReport DeadlineRenderer::render(Renderer& renderer, const RenderParams& p, const std::chrono::milliseconds budget, Image& image)
+    {
+        DeadlineReport report;
+        if (p.width <= 0 || p.height <= 0 || image.width() != p.width || image.height() != p.height)
+        {
+            return report;
+        }
+
+        const auto start = Clock::now();
+        const auto deadline = start + budget;
+        const double full_pixels = static_cast<double>(p.width) * static_cast<double>(p.height);
+
+        // Probe: the same viewport at about probe_pixels pixels, full maxIter
+        const double probe_scale = std::min(1.0, std::sqrt(static_cast<double>(probe_pixels) / full_pixels));
+        const RenderParams probe_params = resized(p, static_cast<int>(std::lround(p.width * probe_scale)), static_cast<int>(std::lround(p.height * probe_scale)));
+        Image probe{probe_params.width, probe_params.height};
+        renderer.render(probe_params, probe);
+        report.previewMs = ms_since(start);
+
+        const double probe_pixels_rendered = static_cast<double>(probe_params.width) * static_cast<double>(probe_params.height);
+        const double ms_per_pixel = report.previewMs / probe_pixels_rendered;
+        report.estimatedMs = ms_per_pixel * full_pixels;
+
+        // Plan: resolution first, since the upscaled image keeps the look, then the iteration cap. Pixels cost at most
+        // in proportion to maxIter, so capping it brings the estimate down at least as much.
+        const double available = std::max(0.0, static_cast<double>(budget.count()) - report.previewMs) * planning_margin;
+        double scale = 1.0;
+        int max_iter = p.maxIter;
+        if (report.estimatedMs > available)
+        {
+            scale = std::max(static_cast<double>(min_scale), std::sqrt(available / report.estimatedMs));
+            const double scaled_ms = report.estimatedMs * scale * scale;
+            if (scaled_ms > available)
+            {
+                const int floor_iter = std::min(p.maxIter, min_iterations);
+                max_iter = std::max(floor_iter, static_cast<int>(static_cast<double>(p.maxIter) * available / scaled_ms));
+            }
+        }
+
+        RenderParams plan = resized(p, static_cast<int>(std::lround(p.width * scale)), static_cast<int>(std::lround(p.height * scale)));
+        plan.maxIter = max_iter;
+        report.width = plan.width;
+        report.height = plan.height;
+        report.maxIter = plan.maxIter;
+        report.degraded = plan.width != p.width || plan.height != p.height || plan.maxIter != p.maxIter;
+
+        const bool full_size = plan.width == p.width && plan.height == p.height;
+        Image scaled;
+        if (!full_size)
+        {
+            scaled = Image{plan.width, plan.height, Image::padded_stride(plan.width)};
+        }
+        Image& target = full_size ? image : scaled;
+
+        RenderTask task = renderer.render_async(plan, target.data(), target.stride());
+        bool completed = false;
+        if (task.wait_until(deadline))
+        {
+            completed = task.get() == RenderStatus::COMPLETED;
+        }
+        else
+        {
+            // Stops once the bands in flight are done; a perturbation render has only the one
+            task.cancel();
+            task.wait();
+        }
+
+        if (!completed)
+        {
+            report.fellBack = true;
+            report.degraded = true;
+            report.width = probe_params.width;
+            report.height = probe_params.height;
+            report.maxIter = p.maxIter;
+            upscale_nearest(probe, image);
+        }
+        else if (!full_size)
+        {
+            upscale_nearest(scaled, image);
+        }
+
+        report.elapsedMs = ms_since(start);
+        return report;
+    }
+}
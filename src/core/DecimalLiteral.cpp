@@ -0,0 +1,99 @@
+#include "core/DecimalLiteral.hpp"
+
+#include <cctype>
+#include <stdexcept>
+
+namespace nfract
+{
+    DecimalLiteral DecimalLiteral::parse(const std::string_view text)
+    {
+        const auto fail = [&text]
+        {
+            return std::invalid_argument("Invalid decimal number: '" + std::string(text) + "'");
+        };
+        const auto is_space = [](const char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+        const auto is_digit = [](const char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+
+        DecimalLiteral literal;
+        std::size_t pos = 0;
+
+        while (pos < text.size() && is_space(text[pos]))
+        {
+            ++pos;
+        }
+
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-'))
+        {
+            literal.negative = text[pos] == '-';
+            ++pos;
+        }
+
+        bool seen_point = false;
+        bool seen_digit = false;
+        for (; pos < text.size(); ++pos)
+        {
+            const char c = text[pos];
+            if (c == '.' && !seen_point)
+            {
+                seen_point = true;
+                continue;
+            }
+            if (!is_digit(c))
+            {
+                break;
+            }
+            seen_digit = true;
+            // Leading zeros carry no information, but the exponent still has to account for them
+            if (!literal.digits.empty() || c != '0')
+            {
+                literal.digits.push_back(c);
+            }
+            if (seen_point)
+            {
+                --literal.exponent;
+            }
+        }
+        if (!seen_digit)
+        {
+            throw fail();
+        }
+
+        if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E'))
+        {
+            ++pos;
+            bool exp_negative = false;
+            if (pos < text.size() && (text[pos] == '+' || text[pos] == '-'))
+            {
+                exp_negative = text[pos] == '-';
+                ++pos;
+            }
+            int exp_value = 0;
+            int exp_digits = 0;
+            for (; pos < text.size() && is_digit(text[pos]); ++pos)
+            {
+                exp_value = exp_value * 10 + (text[pos] - '0');
+                if (exp_value > 100'000)
+                {
+                    throw fail();
+                }
+                ++exp_digits;
+            }
+            if (exp_digits == 0)
+            {
+                throw fail();
+            }
+            literal.exponent += exp_negative ? -exp_value : exp_value;
+        }
+
+        while (pos < text.size() && is_space(text[pos]))
+        {
+            ++pos;
+        }
+        if (pos != text.size())
+        {
+            throw fail();
+        }
+
+        return literal;
+    }
+}
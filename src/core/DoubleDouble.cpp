@@ -0,0 +1,56 @@
+#include "core/DoubleDouble.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "core/DecimalLiteral.hpp"
+
+namespace nfract
+{
+    namespace
+    {
+        [[nodiscard]] DoubleDouble pow10(int exponent) noexcept
+        {
+            DoubleDouble result{1.0};
+            DoubleDouble base{10.0};
+            while (exponent > 0)
+            {
+                if (exponent & 1)
+                {
+                    result = result * base;
+                }
+                base = base * base;
+                exponent >>= 1;
+            }
+            return result;
+        }
+    }
+
+    DoubleDouble DoubleDouble::parse(const std::string_view text)
+    {
+        const DecimalLiteral literal = DecimalLiteral::parse(text);
+        if (literal.digits.empty())
+        {
+            return DoubleDouble{0.0};
+        }
+
+        DoubleDouble mantissa{0.0};
+        for (const char c : literal.digits)
+        {
+            mantissa = mantissa * DoubleDouble{10.0} + DoubleDouble{static_cast<double>(c - '0')};
+        }
+
+        // Scale in bounded steps so tiny literals underflow to zero instead of dividing by infinity
+        int exponent = literal.exponent;
+        for (; exponent < -300; exponent += 300)
+        {
+            mantissa = mantissa / pow10(300);
+        }
+        const DoubleDouble value = exponent >= 0 ? mantissa * pow10(exponent) : mantissa / pow10(-exponent);
+        if (!std::isfinite(value.hi))
+        {
+            throw std::invalid_argument("Decimal number out of range: '" + std::string(text) + "'");
+        }
+        return literal.negative ? -value : value;
+    }
+}
@@ -0,0 +1,769 @@
+#include "core/Expression.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace nfract
+{
+    namespace
+    {
+        struct Node
+        {
+            enum class Kind
+            {
+                CONSTANT,
+                Z,
+                A, // the family parameter
+                ADD,
+                SUB,
+                MUL,
+                NEG,
+                POW,
+            };
+
+            Kind kind;
+            std::complex<double> value{}; // CONSTANT
+            int lhs = -1;
+            int rhs = -1;
+            int exponent = 0; // POW
+        };
+
+        /// Recursive descent over the grammar in core/Expression.hpp. Subtrees without z are folded to constants as
+        /// they are built, which is what lets division and ^ insist on constant operands.
+        class Parser
+        {
+        public:
+            explicit Parser(const std::string_view text) :
+                m_text(text)
+            {
+            }
+
+            [[nodiscard]] int parse()
+            {
+                const int root = sum();
+                skip_spaces();
+                if (m_pos != m_text.size())
+                {
+                    fail("unexpected '" + std::string(1, m_text[m_pos]) + "'");
+                }
+                return root;
+            }
+
+            std::vector<Node> nodes;
+            bool uses_parameter = false;
+
+        private:
+            [[noreturn]] void fail(const std::string& what) const
+            {
+                throw std::invalid_argument("Invalid expression '" + std::string(m_text) + "': " + what);
+            }
+
+            void skip_spaces() noexcept
+            {
+                while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+                {
+                    ++m_pos;
+                }
+            }
+
+            [[nodiscard]] char peek() noexcept
+            {
+                skip_spaces();
+                return m_pos < m_text.size() ? m_text[m_pos] : '\0';
+            }
+
+            [[nodiscard]] bool accept(const char c) noexcept
+            {
+                if (peek() != c)
+                {
+                    return false;
+                }
+                ++m_pos;
+                return true;
+            }
+
+            [[nodiscard]] bool starts_primary() noexcept
+            {
+                const char c = peek();
+                return std::isdigit(static_cast<unsigned char>(c)) || c == '.' || c == 'z' || c == 'a' || c == 'i' || c == '(';
+            }
+
+            [[nodiscard]] bool is_constant(const int node) const noexcept
+            {
+                return nodes[static_cast<std::size_t>(node)].kind == Node::Kind::CONSTANT;
+            }
+
+            [[nodiscard]] std::complex<double> value(const int node) const noexcept
+            {
+                return nodes[static_cast<std::size_t>(node)].value;
+            }
+
+            [[nodiscard]] int add(Node node)
+            {
+                nodes.push_back(node);
+                return static_cast<int>(nodes.size()) - 1;
+            }
+
+            [[nodiscard]] int constant(const std::complex<double> c)
+            {
+                return add({Node::Kind::CONSTANT, c});
+            }
+
+            [[nodiscard]] int binary(const Node::Kind kind, const int lhs, const int rhs)
+            {
+                if (is_constant(lhs) && is_constant(rhs))
+                {
+                    const std::complex<double> a = value(lhs);
+                    const std::complex<double> b = value(rhs);
+                    return constant(kind == Node::Kind::ADD ? a + b : kind == Node::Kind::SUB ? a - b : a * b);
+                }
+                return add({kind, {}, lhs, rhs});
+            }
+
+            // sum := product (('+' | '-') product)*
+            [[nodiscard]] int sum()
+            {
+                int lhs = product();
+                while (true)
+                {
+                    if (accept('+'))
+                    {
+                        lhs = binary(Node::Kind::ADD, lhs, product());
+                    }
+                    else if (accept('-'))
+                    {
+                        lhs = binary(Node::Kind::SUB, lhs, product());
+                    }
+                    else
+                    {
+                        return lhs;
+                    }
+                }
+            }
+
+            // product := unary (('*' | '/') unary | power)*, the bare power being implicit multiplication as in 3z^2
+            [[nodiscard]] int product()
+            {
+                int lhs = unary();
+                while (true)
+                {
+                    if (accept('*'))
+                    {
+                        lhs = binary(Node::Kind::MUL, lhs, unary());
+                    }
+                    else if (accept('/'))
+                    {
+                        const int rhs = unary();
+                        if (!is_constant(rhs))
+                        {
+                            fail("division is only supported by constants");
+                        }
+                        if (value(rhs) == 0.0)
+                        {
+                            fail("division by zero");
+                        }
+                        lhs = binary(Node::Kind::MUL, lhs, constant(1.0 / value(rhs)));
+                    }
+                    else if (starts_primary())
+                    {
+                        lhs = binary(Node::Kind::MUL, lhs, power());
+                    }
+                    else
+                    {
+                        return lhs;
+                    }
+                }
+            }
+
+            // unary := ('-' | '+') unary | power
+            [[nodiscard]] int unary()
+            {
+                if (accept('-'))
+                {
+                    const int operand = unary();
+                    return is_constant(operand) ? constant(-value(operand)) : add({Node::Kind::NEG, {}, operand});
+                }
+                if (accept('+'))
+                {
+                    return unary();
+                }
+                return power();
+            }
+
+            // power := primary ('^' unary)?, right associative through unary
+            [[nodiscard]] int power()
+            {
+                const int base = primary();
+                if (!accept('^'))
+                {
+                    return base;
+                }
+
+                const int exponent_node = unary();
+                const std::complex<double> e = value(exponent_node);
+                if (!is_constant(exponent_node) || e.imag() != 0.0 || e.real() < 0.0 || e.real() != std::floor(e.real()))
+                {
+                    fail("exponents must be non-negative integer constants");
+                }
+                if (e.real() > Expression::max_degree)
+                {
+                    fail("exponent exceeds " + std::to_string(Expression::max_degree));
+                }
+
+                const int exponent = static_cast<int>(e.real());
+                if (is_constant(base))
+                {
+                    std::complex<double> result{1.0, 0.0};
+                    for (int k = 0; k < exponent; ++k)
+                    {
+                        result *= value(base);
+                    }
+                    return constant(result);
+                }
+                if (exponent == 0)
+                {
+                    return constant({1.0, 0.0});
+                }
+                if (exponent == 1)
+                {
+                    return base;
+                }
+                return add({Node::Kind::POW, {}, base, -1, exponent});
+            }
+
+            // primary := number ['i'] | 'i' | 'z' | 'a' | '(' sum ')'
+            [[nodiscard]] int primary()
+            {
+                const char c = peek();
+                if (c == 'z' || c == 'i')
+                {
+                    ++m_pos;
+                    return c == 'z' ? add({Node::Kind::Z}) : constant({0.0, 1.0});
+                }
+                if (c == 'a')
+                {
+                    ++m_pos;
+                    uses_parameter = true;
+                    return add({Node::Kind::A});
+                }
+                if (accept('('))
+                {
+                    const int inner = sum();
+                    if (!accept(')'))
+                    {
+                        fail("missing ')'");
+                    }
+                    return inner;
+                }
+                if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+                {
+                    return number();
+                }
+                if (c == '\0')
+                {
+                    fail("unexpected end");
+                }
+                fail("unexpected '" + std::string(1, c) + "'");
+            }
+
+            [[nodiscard]] int number()
+            {
+                const auto is_digit = [this](const std::size_t i)
+                {
+                    return i < m_text.size() && std::isdigit(static_cast<unsigned char>(m_text[i]));
+                };
+
+                const std::size_t begin = m_pos;
+                bool digits = false;
+                while (is_digit(m_pos) || (m_pos < m_text.size() && m_text[m_pos] == '.'))
+                {
+                    digits = digits || is_digit(m_pos);
+                    ++m_pos;
+                }
+                if (!digits)
+                {
+                    fail("malformed number");
+                }
+                if (m_pos < m_text.size() && (m_text[m_pos] == 'e' || m_text[m_pos] == 'E'))
+                {
+                    std::size_t end = m_pos + 1;
+                    if (end < m_text.size() && (m_text[end] == '+' || m_text[end] == '-'))
+                    {
+                        ++end;
+                    }
+                    if (!is_digit(end))
+                    {
+                        fail("malformed exponent");
+                    }
+                    while (is_digit(end))
+                    {
+                        ++end;
+                    }
+                    m_pos = end;
+                }
+
+                const std::string literal{m_text.substr(begin, m_pos - begin)};
+                char* end = nullptr;
+                const double x = std::strtod(literal.c_str(), &end);
+                if (end != literal.c_str() + literal.size())
+                {
+                    fail("malformed number '" + literal + "'");
+                }
+
+                // 2i is an imaginary literal, not 2 * i, so it binds tighter than ^
+                if (m_pos < m_text.size() && m_text[m_pos] == 'i')
+                {
+                    ++m_pos;
+                    return constant({0.0, x});
+                }
+                return constant({x, 0.0});
+            }
+
+            std::string_view m_text;
+            std::size_t m_pos = 0;
+        };
+
+        /// Coefficient base + a slope of a family affine in the parameter a (slope is 0 without a)
+        struct Affine
+        {
+            std::complex<double> base;
+            std::complex<double> slope;
+        };
+
+        using Coefficients = std::vector<Affine>; // lowest degree first
+
+        [[nodiscard]] bool has_slope(const Coefficients& c) noexcept
+        {
+            return std::ranges::any_of(c, [](const Affine& t) { return t.slope != 0.0; });
+        }
+
+        [[nodiscard]] Coefficients multiply(const Coefficients& a, const Coefficients& b)
+        {
+            if (a.size() + b.size() - 2 > static_cast<std::size_t>(Expression::max_degree))
+            {
+                throw std::invalid_argument("Invalid expression: degree exceeds " + std::to_string(Expression::max_degree));
+            }
+            if (has_slope(a) && has_slope(b))
+            {
+                throw std::invalid_argument("Invalid expression: must be affine in the parameter a");
+            }
+
+            Coefficients r(a.size() + b.size() - 1);
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                for (std::size_t j = 0; j < b.size(); ++j)
+                {
+                    r[i + j].base += a[i].base * b[j].base;
+                    r[i + j].slope += a[i].base * b[j].slope + a[i].slope * b[j].base;
+                }
+            }
+            return r;
+        }
+
+        [[nodiscard]] Coefficients expand(const std::vector<Node>& nodes, const int index)
+        {
+            const Node& node = nodes[static_cast<std::size_t>(index)];
+            switch (node.kind)
+            {
+            case Node::Kind::CONSTANT:
+                return {{node.value, 0.0}};
+            case Node::Kind::Z:
+                return {{0.0, 0.0}, {1.0, 0.0}};
+            case Node::Kind::A:
+                return {{0.0, 1.0}};
+            case Node::Kind::NEG:
+            {
+                Coefficients r = expand(nodes, node.lhs);
+                for (auto& c : r)
+                {
+                    c = {-c.base, -c.slope};
+                }
+                return r;
+            }
+            case Node::Kind::MUL:
+                return multiply(expand(nodes, node.lhs), expand(nodes, node.rhs));
+            case Node::Kind::POW:
+            {
+                const Coefficients base = expand(nodes, node.lhs);
+                Coefficients r{{1.0, 0.0}};
+                for (int k = 0; k < node.exponent; ++k)
+                {
+                    r = multiply(r, base);
+                }
+                return r;
+            }
+            case Node::Kind::ADD:
+            case Node::Kind::SUB:
+            default:
+            {
+                Coefficients a = expand(nodes, node.lhs);
+                const Coefficients b = expand(nodes, node.rhs);
+                a.resize(std::max(a.size(), b.size()));
+                const double sign = node.kind == Node::Kind::ADD ? 1.0 : -1.0;
+                for (std::size_t k = 0; k < b.size(); ++k)
+                {
+                    a[k].base += sign * b[k].base;
+                    a[k].slope += sign * b[k].slope;
+                }
+                return a;
+            }
+            }
+        }
+
+        /// Emits each subtree into a target register, using the registers above it as scratch, so the register count
+        /// is bounded by the nesting depth. Constant operands become immediate SCALE / OFFSET operations.
+        class Compiler
+        {
+        public:
+            explicit Compiler(const std::vector<Node>& nodes) :
+                m_nodes(nodes)
+            {
+            }
+
+            void emit(const int index, const int target)
+            {
+                use(target);
+                const Node& node = m_nodes[static_cast<std::size_t>(index)];
+                const auto constant_operand = [this](const int operand) -> const std::complex<double>*
+                {
+                    const Node& n = m_nodes[static_cast<std::size_t>(operand)];
+                    return n.kind == Node::Kind::CONSTANT ? &n.value : nullptr;
+                };
+
+                switch (node.kind)
+                {
+                case Node::Kind::CONSTANT:
+                    push(Expression::Op::LOAD_CONST, target, constant(node.value), 0);
+                    break;
+                case Node::Kind::Z:
+                    push(Expression::Op::LOAD_Z, target, 0, 0);
+                    break;
+                case Node::Kind::NEG:
+                    emit(node.lhs, target);
+                    push(Expression::Op::NEG, target, target, 0);
+                    break;
+                case Node::Kind::ADD:
+                case Node::Kind::SUB:
+                case Node::Kind::MUL:
+                {
+                    const bool is_mul = node.kind == Node::Kind::MUL;
+                    const Expression::Op immediate = is_mul ? Expression::Op::SCALE : Expression::Op::OFFSET;
+                    if (const auto* c = constant_operand(node.rhs))
+                    {
+                        emit(node.lhs, target);
+                        push(immediate, target, target, constant(node.kind == Node::Kind::SUB ? -*c : *c));
+                    }
+                    else if (const auto* c = constant_operand(node.lhs))
+                    {
+                        emit(node.rhs, target);
+                        if (node.kind == Node::Kind::SUB)
+                        {
+                            push(Expression::Op::NEG, target, target, 0);
+                        }
+                        push(immediate, target, target, constant(*c));
+                    }
+                    else
+                    {
+                        const Expression::Op op = is_mul ? Expression::Op::MUL : node.kind == Node::Kind::ADD ? Expression::Op::ADD : Expression::Op::SUB;
+                        emit(node.lhs, target);
+                        emit(node.rhs, target + 1);
+                        push(op, target, target, target + 1);
+                    }
+                    break;
+                }
+                case Node::Kind::POW:
+                default:
+                    emit(node.lhs, target);
+                    emit_power(target, node.exponent);
+                    break;
+                }
+            }
+
+            std::vector<Expression::Instruction> code;
+            std::vector<std::complex<double>> constants;
+            int registers = 0;
+
+        private:
+            void use(const int reg)
+            {
+                if (reg >= Expression::max_registers)
+                {
+                    throw std::invalid_argument("Invalid expression: nested too deeply");
+                }
+                registers = std::max(registers, reg + 1);
+            }
+
+            void push(const Expression::Op op, const int dst, const int a, const int b)
+            {
+                code.push_back({op, static_cast<std::uint8_t>(dst), static_cast<std::uint8_t>(a), static_cast<std::uint8_t>(b)});
+            }
+
+            [[nodiscard]] int constant(const std::complex<double> c)
+            {
+                const auto it = std::ranges::find(constants, c);
+                if (it != constants.end())
+                {
+                    return static_cast<int>(it - constants.begin());
+                }
+                if (constants.size() >= static_cast<std::size_t>(Expression::max_constants))
+                {
+                    throw std::invalid_argument("Invalid expression: too many constants");
+                }
+                constants.push_back(c);
+                return static_cast<int>(constants.size()) - 1;
+            }
+
+            /// r[target] ^= exponent by square-and-multiply, accumulating in r[target + 1]
+            void emit_power(const int target, int exponent)
+            {
+                if ((exponent & (exponent - 1)) == 0)
+                {
+                    for (; exponent > 1; exponent >>= 1)
+                    {
+                        push(Expression::Op::MUL, target, target, target);
+                    }
+                    return;
+                }
+
+                const int acc = target + 1;
+                use(acc);
+                bool started = false;
+                while (true)
+                {
+                    if (exponent & 1)
+                    {
+                        push(started ? Expression::Op::MUL : Expression::Op::MOV, acc, started ? acc : target, target);
+                        started = true;
+                    }
+                    exponent >>= 1;
+                    if (exponent == 0)
+                    {
+                        break;
+                    }
+                    push(Expression::Op::MUL, target, target, target);
+                }
+                push(Expression::Op::MOV, target, acc, 0);
+            }
+
+            const std::vector<Node>& m_nodes;
+        };
+    }
+
+    Expression Expression::parse(const std::string_view text)
+    {
+        Parser parser{text};
+        const int root = parser.parse();
+
+        Coefficients coefficients = expand(parser.nodes, root);
+        while (coefficients.size() > 1 && coefficients.back().base == 0.0 && coefficients.back().slope == 0.0)
+        {
+            coefficients.pop_back();
+        }
+        if (coefficients.size() < 2)
+        {
+            throw std::invalid_argument("Invalid expression '" + std::string(text) + "': must be a polynomial of degree >= 1 in z");
+        }
+
+        Expression expression;
+        for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it)
+        {
+            expression.m_coefficients.push_back(it->base);
+            if (parser.uses_parameter)
+            {
+                expression.m_parameter_coefficients.push_back(it->slope);
+            }
+        }
+
+        // A family is evaluated from its per-pixel coefficients, never interpreted
+        if (parser.uses_parameter)
+        {
+            return expression;
+        }
+
+        Compiler compiler{parser.nodes};
+        compiler.emit(root, 0);
+
+        expression.m_code = std::move(compiler.code);
+        expression.m_registers = compiler.registers;
+        for (const auto& c : compiler.constants)
+        {
+            expression.m_constants_re.push_back(static_cast<float>(c.real()));
+            expression.m_constants_im.push_back(static_cast<float>(c.imag()));
+        }
+        return expression;
+    }
+
+    bool Expression::has_parameter() const noexcept
+    {
+        return !m_parameter_coefficients.empty();
+    }
+
+    std::span<const Expression::Instruction> Expression::code() const noexcept
+    {
+        return m_code;
+    }
+
+    int Expression::registers() const noexcept
+    {
+        return m_registers;
+    }
+
+    std::span<const float> Expression::constants_re() const noexcept
+    {
+        return m_constants_re;
+    }
+
+    std::span<const float> Expression::constants_im() const noexcept
+    {
+        return m_constants_im;
+    }
+
+    std::span<const std::complex<double>> Expression::coefficients() const noexcept
+    {
+        return m_coefficients;
+    }
+
+    std::span<const std::complex<double>> Expression::parameter_coefficients() const noexcept
+    {
+        return m_parameter_coefficients;
+    }
+
+    template <int Order>
+    void Expression::evaluate(const float* z_re, const float* z_im, const std::span<JetBatch<Order>> scratch) const noexcept
+    {
+        constexpr int B = batch_lanes;
+
+        // Every case is a loop over lanes with no cross-lane dependency, so each one vectorizes on its own
+        for (const Instruction& ins : m_code)
+        {
+            JetBatch<Order>& d = scratch[ins.dst];
+            switch (ins.op)
+            {
+            case Op::LOAD_Z:
+                d = JetBatch<Order>{};
+                std::copy_n(z_re, B, d.re[0].begin());
+                std::copy_n(z_im, B, d.im[0].begin());
+                if constexpr (Order >= 1)
+                {
+                    d.re[1].fill(1.0f);
+                }
+                break;
+            case Op::LOAD_CONST:
+                d = JetBatch<Order>{};
+                d.re[0].fill(m_constants_re[ins.a]);
+                d.im[0].fill(m_constants_im[ins.a]);
+                break;
+            case Op::MOV:
+                d = scratch[ins.a];
+                break;
+            case Op::ADD:
+            {
+                const JetBatch<Order>& a = scratch[ins.a];
+                const JetBatch<Order>& b = scratch[ins.b];
+                for (int k = 0; k <= Order; ++k)
+                {
+                    for (int l = 0; l < B; ++l)
+                    {
+                        d.re[k][l] = a.re[k][l] + b.re[k][l];
+                        d.im[k][l] = a.im[k][l] + b.im[k][l];
+                    }
+                }
+                break;
+            }
+            case Op::SUB:
+            {
+                const JetBatch<Order>& a = scratch[ins.a];
+                const JetBatch<Order>& b = scratch[ins.b];
+                for (int k = 0; k <= Order; ++k)
+                {
+                    for (int l = 0; l < B; ++l)
+                    {
+                        d.re[k][l] = a.re[k][l] - b.re[k][l];
+                        d.im[k][l] = a.im[k][l] - b.im[k][l];
+                    }
+                }
+                break;
+            }
+            case Op::NEG:
+            {
+                const JetBatch<Order>& a = scratch[ins.a];
+                for (int k = 0; k <= Order; ++k)
+                {
+                    for (int l = 0; l < B; ++l)
+                    {
+                        d.re[k][l] = -a.re[k][l];
+                        d.im[k][l] = -a.im[k][l];
+                    }
+                }
+                break;
+            }
+            case Op::MUL:
+            {
+                // Truncated Cauchy product, highest term first: d[k] only reads a[0..k] and b[0..k], so d may alias
+                // either operand (squaring in place included)
+                const JetBatch<Order>& a = scratch[ins.a];
+                const JetBatch<Order>& b = scratch[ins.b];
+                for (int k = Order; k >= 0; --k)
+                {
+                    std::array<float, B> sr;
+                    std::array<float, B> si;
+                    for (int l = 0; l < B; ++l)
+                    {
+                        sr[l] = a.re[0][l] * b.re[k][l] - a.im[0][l] * b.im[k][l];
+                        si[l] = a.re[0][l] * b.im[k][l] + a.im[0][l] * b.re[k][l];
+                    }
+                    for (int i = 1; i <= k; ++i)
+                    {
+                        for (int l = 0; l < B; ++l)
+                        {
+                            sr[l] = sr[l] + (a.re[i][l] * b.re[k - i][l] - a.im[i][l] * b.im[k - i][l]);
+                            si[l] = si[l] + (a.re[i][l] * b.im[k - i][l] + a.im[i][l] * b.re[k - i][l]);
+                        }
+                    }
+                    d.re[k] = sr;
+                    d.im[k] = si;
+                }
+                break;
+            }
+            case Op::SCALE:
+            {
+                const JetBatch<Order>& a = scratch[ins.a];
+                const float cr = m_constants_re[ins.b];
+                const float ci = m_constants_im[ins.b];
+                for (int k = 0; k <= Order; ++k)
+                {
+                    for (int l = 0; l < B; ++l)
+                    {
+                        const float re = a.re[k][l];
+                        const float im = a.im[k][l];
+                        d.re[k][l] = re * cr - im * ci;
+                        d.im[k][l] = re * ci + im * cr;
+                    }
+                }
+                break;
+            }
+            case Op::OFFSET:
+                if (ins.dst != ins.a)
+                {
+                    d = scratch[ins.a];
+                }
+                for (int l = 0; l < B; ++l)
+                {
+                    d.re[0][l] += m_constants_re[ins.b];
+                    d.im[0][l] += m_constants_im[ins.b];
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    template void Expression::evaluate<1>(const float*, const float*, std::span<JetBatch<1>>) const noexcept;
+    template void Expression::evaluate<2>(const float*, const float*, std::span<JetBatch<2>>) const noexcept;
+    template void Expression::evaluate<3>(const float*, const float*, std::span<JetBatch<3>>) const noexcept;
+}
@@ -9,21 +9,36 @@
 namespace nfract
 {
     Image::Image(const int width, const int height) :
+        Image(width, height, static_cast<std::size_t>(width > 0 ? width : 0) * 4u)
+    {
+    }
+
+    Image::Image(const int width, const int height, const std::size_t stride) :
         m_width(width),
-        m_height(height)
+        m_height(height),
+        m_stride(stride)
     {
         if (width < 0 || height < 0)
         {
             throw std::invalid_argument("Image dimensions must be non-negative");
         }
+        if (stride < static_cast<std::size_t>(width) * 4u)
+        {
+            throw std::invalid_argument("Image stride must hold a row of pixels");
+        }
 
         if (width > 0 && height > 0)
         {
-            const auto count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u;
-            m_pixels.resize(count, pixel_type{0});
+            m_pixels.resize(stride * static_cast<std::size_t>(height), pixel_type{0});
         }
     }
 
+    std::size_t Image::padded_stride(const int width) noexcept
+    {
+        const std::size_t row_bytes = static_cast<std::size_t>(width > 0 ? width : 0) * 4u;
+        return (row_bytes + alignment - 1) / alignment * alignment;
+    }
+
     int Image::width() const noexcept
     {
         return m_width;
@@ -34,6 +49,11 @@ namespace nfract
         return m_height;
     }
 
+    std::size_t Image::stride() const noexcept
+    {
+        return m_stride;
+    }
+
     bool Image::empty() const noexcept
     {
         return m_width <= 0 || m_height <= 0 || m_pixels.empty();
@@ -45,7 +65,7 @@ namespace nfract
         {
             throw std::out_of_range("Image::row index out of range");
         }
-        const auto offset = static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width) * 4u;
+        const auto offset = static_cast<std::size_t>(y) * m_stride;
         return std::span{
             m_pixels.data() + offset,
             static_cast<std::size_t>(m_width) * 4u
@@ -58,7 +78,7 @@ namespace nfract
         {
             throw std::out_of_range("Image::row index out of range");
         }
-        const auto offset = static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width) * 4u;
+        const auto offset = static_cast<std::size_t>(y) * m_stride;
         return std::span{
             m_pixels.data() + offset,
             static_cast<std::size_t>(m_width) * 4u
@@ -75,7 +95,7 @@ namespace nfract
         {
             throw std::out_of_range("Image::pixel y index out of range");
         }
-        const auto idx = (static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width) + static_cast<std::size_t>(x)) * 4u;
+        const auto idx = static_cast<std::size_t>(y) * m_stride + static_cast<std::size_t>(x) * 4u;
         return m_pixels.data() + idx;
     }
 
@@ -89,7 +109,7 @@ namespace nfract
         {
             throw std::out_of_range("Image::pixel y index out of range");
         }
-        const auto idx = (static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width) + static_cast<std::size_t>(x)) * 4u;
+        const auto idx = static_cast<std::size_t>(y) * m_stride + static_cast<std::size_t>(x) * 4u;
         return m_pixels.data() + idx;
     }
 
@@ -113,6 +133,11 @@ namespace nfract
         return m_pixels;
     }
 
+    ImageView Image::view() noexcept
+    {
+        return {m_pixels.data(), m_width, m_height, m_stride};
+    }
+
     bool Image::save_png(const std::filesystem::path& path, std::optional<int> stride_bytes) const noexcept
     {
         if (empty())
@@ -121,7 +146,7 @@ namespace nfract
         }
 
         const auto filename = path.string();
-        const int result = stbi_write_png(filename.c_str(), m_width, m_height, 4, m_pixels.data(), stride_bytes.value_or(m_width * 4));
+        const int result = stbi_write_png(filename.c_str(), m_width, m_height, 4, m_pixels.data(), stride_bytes.value_or(static_cast<int>(m_stride)));
 
         return result != 0;
     }
@@ -0,0 +1,66 @@
+#include "core/IterationBudget.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "core/RenderNewton.hpp"
+
+namespace nfract
+{
+    IterationChoice IterationBudget::choose(Renderer& renderer, const RenderParams& p, const double coverage)
+    {
+        IterationChoice choice;
+        if (p.width <= 0 || p.height <= 0)
+        {
+            return choice;
+        }
+
+        // The same viewport at about probe_pixels pixels (pixel centres on the same corners)
+        const double scale = std::min(1.0, std::sqrt(static_cast<double>(probe_pixels) / (static_cast<double>(p.width) * static_cast<double>(p.height))));
+        RenderParams probe = p;
+        probe.width = std::max(1, static_cast<int>(std::lround(p.width * scale)));
+        probe.height = std::max(1, static_cast<int>(std::lround(p.height * scale)));
+        probe.maxIter = ceiling;
+        choice.probeWidth = probe.width;
+        choice.probeHeight = probe.height;
+
+        std::vector<FieldSample> field(static_cast<std::size_t>(probe.width) * static_cast<std::size_t>(probe.height));
+        renderer.render_field(probe, field.data(), static_cast<std::size_t>(probe.width));
+
+        // Converged as the palettes see it: stopped early, close to a root
+        const float tol2 = p.tolerance * p.tolerance;
+        std::vector<int> histogram(ceiling, 0);
+        int converged = 0;
+        for (const FieldSample& sample : field)
+        {
+            if (sample.iter >= 0 && sample.iter < ceiling && sample.dist2 < tol2)
+            {
+                ++histogram[static_cast<std::size_t>(sample.iter)];
+                ++converged;
+            }
+        }
+        choice.converging = static_cast<double>(converged) / static_cast<double>(field.size());
+        if (converged == 0)
+        {
+            choice.maxIter = ceiling;
+            return choice;
+        }
+
+        // A pixel that converges after k iterations needs a budget of k + 1
+        const double wanted = std::ceil(std::clamp(coverage, 0.0, 1.0) * static_cast<double>(converged));
+        int covered = 0;
+        choice.maxIter = ceiling;
+        for (int k = 0; k < ceiling; ++k)
+        {
+            covered += histogram[static_cast<std::size_t>(k)];
+            if (static_cast<double>(covered) >= wanted)
+            {
+                choice.maxIter = k + 1;
+                break;
+            }
+        }
+        choice.coverage = static_cast<double>(covered) / static_cast<double>(converged);
+        return choice;
+    }
+}
@@ -0,0 +1,82 @@
+#include "core/Polynomial.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace nfract
+{
+    Polynomial::Polynomial(const std::span<const std::complex<double>> coefficients)
+    {
+        const auto first = std::ranges::find_if(coefficients, [](const std::complex<double>& c) { return c != 0.0; });
+        m_coefficients.assign(first, coefficients.end());
+
+        if (m_coefficients.size() < 2)
+        {
+            throw std::invalid_argument("Polynomial degree must be at least 1");
+        }
+
+        const int n = degree();
+        m_re.reserve(m_coefficients.size());
+        m_im.reserve(m_coefficients.size());
+        m_derivative_re.reserve(static_cast<std::size_t>(n));
+        m_derivative_im.reserve(static_cast<std::size_t>(n));
+
+        for (int k = 0; k <= n; ++k)
+        {
+            const auto& c = m_coefficients[static_cast<std::size_t>(k)];
+            m_re.push_back(static_cast<value_type>(c.real()));
+            m_im.push_back(static_cast<value_type>(c.imag()));
+
+            // a_k z^(n-k) differentiates to (n-k) a_k z^(n-k-1)
+            if (k < n)
+            {
+                const auto d = c * static_cast<double>(n - k);
+                m_derivative_re.push_back(static_cast<value_type>(d.real()));
+                m_derivative_im.push_back(static_cast<value_type>(d.imag()));
+            }
+        }
+    }
+
+    Polynomial Polynomial::unity(const int n)
+    {
+        if (n <= 0)
+        {
+            throw std::invalid_argument("Polynomial degree must be at least 1");
+        }
+
+        std::vector<std::complex<double>> coefficients(static_cast<std::size_t>(n) + 1, 0.0);
+        coefficients.front() = 1.0;
+        coefficients.back() = -1.0;
+        return Polynomial{coefficients};
+    }
+
+    int Polynomial::degree() const noexcept
+    {
+        return m_coefficients.empty() ? 0 : static_cast<int>(m_coefficients.size()) - 1;
+    }
+
+    std::span<const std::complex<double>> Polynomial::coefficients() const noexcept
+    {
+        return m_coefficients;
+    }
+
+    std::span<const Polynomial::value_type> Polynomial::re() const noexcept
+    {
+        return m_re;
+    }
+
+    std::span<const Polynomial::value_type> Polynomial::im() const noexcept
+    {
+        return m_im;
+    }
+
+    std::span<const Polynomial::value_type> Polynomial::derivative_re() const noexcept
+    {
+        return m_derivative_re;
+    }
+
+    std::span<const Polynomial::value_type> Polynomial::derivative_im() const noexcept
+    {
+        return m_derivative_im;
+    }
+}
@@ -1,8 +1,21 @@
 #include <core/RenderNewton.hpp>
 
+#include <core/BigFloat.hpp>
+#include <core/DoubleDouble.hpp>
+#include <core/Expression.hpp>
+#include <core/FastMath.hpp>
+#include <core/IterationKernel.hpp>
+#include <core/Polynomial.hpp>
+#include <core/TileCertifier.hpp>
+
 #include <limits>
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <complex>
+#include <span>
+#include <type_traits>
+#include <vector>
 #ifndef RUN_ON_CPU
 #include <Newton_ispc.h>
 #endif
@@ -11,12 +24,6 @@ namespace nfract
 {
     namespace
     {
-        struct Complex
-        {
-            float re;
-            float im;
-        };
-
         [[nodiscard]] float clamp01(const float x) noexcept
         {
             return std::clamp(x, 0.0f, 1.0f);
@@ -27,29 +34,6 @@ namespace nfract
             return static_cast<std::uint8_t>(clamp01(x) * 255.0f + 0.5f);
         }
 
-        [[nodiscard]] Complex mul(const Complex a, const Complex b) noexcept
-        {
-            return {
-                a.re * b.re - a.im * b.im,
-                a.re * b.im + a.im * b.re
-            };
-        }
-
-        [[nodiscard]] float abs2(const Complex z) noexcept
-        {
-            return z.re * z.re + z.im * z.im;
-        }
-
-        [[nodiscard]] Complex pow_int(const Complex z, const int k) noexcept
-        {
-            Complex res{1.0f, 0.0f};
-            for (int i = 0; i < k; ++i)
-            {
-                res = mul(res, z);
-            }
-            return res;
-        }
-
         void hsv_to_rgb_f(float h, const float s, const float v, float& rf, float& gf, float& bf) noexcept
         {
             if (s <= 0.0f)
@@ -125,9 +109,24 @@ namespace nfract
             B = to_u8(bf);
         }
 
-        [[nodiscard]] float compute_continuous_iteration(const int iter, const float bestDist2) noexcept
+        /// compute_continuous_iteration() with the logarithms swapped for fast_log2() (see core/FastMath.hpp) and no square
+        /// root. Straight-line code, so a loop over it can vectorize.
+        [[nodiscard]] float fast_continuous_iteration(const int iter, const float bestDist2) noexcept
+        {
+            constexpr float LOG2_SMOOTH = -13.2877124f;
+            const float log2_d = 0.5f * fast_log2(std::max(bestDist2, 1.0e-24f));
+            const float ratio = std::max(log2_d / LOG2_SMOOTH, 1.0e-12f);
+            return static_cast<float>(iter) - fast_log2(ratio);
+        }
+
+        /// `fast` selects fast_continuous_iteration()
+        [[nodiscard]] float compute_continuous_iteration(const int iter, const float bestDist2, const bool fast) noexcept
         {
             constexpr float SMOOTH = 1.0e-4f;
+            if (fast)
+            {
+                return fast_continuous_iteration(iter, bestDist2);
+            }
 
             float d = std::sqrt(bestDist2);
             d = std::max(d, 1.0e-12f);
@@ -138,16 +137,16 @@ namespace nfract
             return static_cast<float>(iter) - std::log(ratio) / std::log(2.0f);
         }
 
-        void shade_jewelry(const int iter, const int maxIter, const int bestIdx, const int numRoots, const float bestDist2, std::uint8_t& R, std::uint8_t& G, std::uint8_t& B) noexcept
+        void shade_jewelry(const int iter, const int maxIter, const float hue, const float bestDist2, const bool fast, std::uint8_t& R, std::uint8_t& G, std::uint8_t& B) noexcept
         {
-            if (maxIter <= 0 || numRoots <= 0)
+            if (maxIter <= 0)
             {
                 R = G = B = 0;
                 return;
             }
 
-            const float ci = compute_continuous_iteration(iter, bestDist2);
-            const float color_value = 0.7f + 0.3f * std::cos(0.18f * ci);
+            const float ci = compute_continuous_iteration(iter, bestDist2, fast);
+            const float color_value = 0.7f + 0.3f * (fast ? fast_cos(0.18f * ci) : std::cos(0.18f * ci));
 
             if (iter == maxIter)
             {
@@ -155,7 +154,7 @@ namespace nfract
                 return;
             }
 
-            const float h_base = static_cast<float>(bestIdx) / static_cast<float>(numRoots);
+            const float h_base = hue;
             const float h_highlight = h_base + 2.0f / 3.0f;
 
             float br{}, bg{}, bb{};
@@ -173,22 +172,41 @@ namespace nfract
             B = to_byte01(bf);
         }
 
-        void shade_neon(const int iter, [[maybe_unused]] const int maxIter, const float bestDist2, std::uint8_t& R, std::uint8_t& G, std::uint8_t& B) noexcept
+        void shade_neon(const int iter, [[maybe_unused]] const int maxIter, const float bestDist2, const bool fast, std::uint8_t& R, std::uint8_t& G, std::uint8_t& B) noexcept
         {
-            const float ci = compute_continuous_iteration(iter, bestDist2);
+            const float ci = compute_continuous_iteration(iter, bestDist2, fast);
+            const auto cosine = [fast](const float x) noexcept { return fast ? fast_cos(x) : std::cos(x); };
 
-            const float rf = (-std::cos(0.025f * ci) + 1.0f) * 0.5f;
-            const float gf = (-std::cos(0.08f * ci) + 1.0f) * 0.5f;
-            const float bf = (-std::cos(0.12f * ci) + 1.0f) * 0.5f;
+            const float rf = (-cosine(0.025f * ci) + 1.0f) * 0.5f;
+            const float gf = (-cosine(0.08f * ci) + 1.0f) * 0.5f;
+            const float bf = (-cosine(0.12f * ci) + 1.0f) * 0.5f;
 
             R = to_byte01(rf);
             G = to_byte01(gf);
             B = to_byte01(bf);
         }
 
-        void shade_classic(const int iter, const int maxIter, const int bestIdx, const int numRoots, std::uint8_t& R, std::uint8_t& G, std::uint8_t& B) noexcept
+        /// Histogram bin of a converged sample's continuous iteration count, over [0, maxIter]
+        [[nodiscard]] int equalization_bin(const int iter, const int maxIter, const float bestDist2) noexcept
+        {
+            const float ci = compute_continuous_iteration(iter, bestDist2, false);
+            const float share = maxIter > 0 ? ci / static_cast<float>(maxIter) : 0.0f;
+            return std::clamp(static_cast<int>(share * static_cast<float>(equalization_bins)), 0, equalization_bins - 1);
+        }
+
+        /// Brightest for the fastest converging pixels of the frame, down to 0.15 for the slowest, so they stay apart
+        /// from the black of pixels that did not converge. Without ranks the share of the budget used stands in.
+        void shade_equalized(const int iter, const int maxIter, const float hue, const float bestDist2, const std::span<const float> ranks, std::uint8_t& R, std::uint8_t& G, std::uint8_t& B) noexcept
+        {
+            const int bin = equalization_bin(iter, maxIter, bestDist2);
+            const float rank = ranks.size() == static_cast<std::size_t>(equalization_bins)
+                                   ? ranks[static_cast<std::size_t>(bin)]
+                                   : static_cast<float>(bin) / static_cast<float>(equalization_bins);
+            hsv_to_rgb(hue, 1.0f, 1.0f - 0.85f * rank, R, G, B);
+        }
+
+        void shade_classic(const int iter, const int maxIter, const float hue, std::uint8_t& R, std::uint8_t& G, std::uint8_t& B) noexcept
         {
-            const float hue = numRoots > 0 ? static_cast<float>(bestIdx) / static_cast<float>(numRoots) : 0.0f;
             const float t = maxIter > 1
                                 ? 1.0f - static_cast<float>(iter) / static_cast<float>(maxIter)
                                 : 1.0f;
@@ -197,137 +215,1422 @@ namespace nfract
 
             hsv_to_rgb(hue, sat, value, R, G, B);
         }
-    }
 
-    void render_newton_cpu(const Arguments& p, const RootsTable& roots, Image& image)
-    {
-        const int W = p.width;
-        const int H = p.height;
+        /// `hue` in [0, 1) names the root the pixel reached (see the classifiers in core/IterationKernel.hpp)
+        void shade_pixel(const RenderParams& p, const int iter, const float hue, const float bestDist2, const float tol2, std::uint8_t* pix, const std::span<const float> ranks = {}) noexcept
+        {
+            // Color: hue from the root, value = based on iterations
+            std::uint8_t R{}, G{}, B{};
+            if (iter != p.maxIter && bestDist2 < tol2)
+            {
+                switch (p.colorMode)
+                {
+                case ColorMode::JEWELRY:
+                    shade_jewelry(iter, p.maxIter, hue, bestDist2, p.fastShading, R, G, B);
+                    break;
+                case ColorMode::NEON:
+                    shade_neon(iter, p.maxIter, bestDist2, p.fastShading, R, G, B);
+                    break;
+                case ColorMode::EQUALIZED:
+                    shade_equalized(iter, p.maxIter, hue, bestDist2, ranks, R, G, B);
+                    break;
+                case ColorMode::CLASSIC:
+                default:
+                    shade_classic(iter, p.maxIter, hue, R, G, B);
+                    break;
+                }
+            }
 
-        if (W <= 0 || H <= 0 || image.width() != W || image.height() != H)
-            return;
+            pix[0] = R;
+            pix[1] = G;
+            pix[2] = B;
+            pix[3] = 255;
+        }
 
-        const float dx = (p.xmax - p.xmin) / static_cast<float>(std::max(1, W - 1));
-        const float dy = (p.ymax - p.ymin) / static_cast<float>(std::max(1, H - 1));
+        /// shade_pixel() for ColorMode::NEON with --fast-math-shading over `count` samples, channel by channel into the
+        /// planes r, g and b. Every pixel is shaded and the ones that did not converge are masked to black, so the loop
+        /// has no branches or calls and the compiler vectorizes it (given -fno-trapping-math, see CMakeLists.txt),
+        /// storing whole vectors of each channel to its plane.
+        void shade_row_neon_fast(const FieldSample* samples, const int count, const int maxIter, const float tol2, std::uint8_t* r, std::uint8_t* g, std::uint8_t* b) noexcept
+        {
+            for (int x = 0; x < count; ++x)
+            {
+                const FieldSample& sample = samples[x];
+                const float ci = fast_continuous_iteration(sample.iter, sample.dist2);
+                const std::uint8_t R = to_byte01((-fast_cos(0.025f * ci) + 1.0f) * 0.5f);
+                const std::uint8_t G = to_byte01((-fast_cos(0.08f * ci) + 1.0f) * 0.5f);
+                const std::uint8_t B = to_byte01((-fast_cos(0.12f * ci) + 1.0f) * 0.5f);
+                const bool converged = sample.iter != maxIter && sample.dist2 < tol2;
+                r[x] = converged ? R : std::uint8_t{0};
+                g[x] = converged ? G : std::uint8_t{0};
+                b[x] = converged ? B : std::uint8_t{0};
+            }
+        }
 
-        const auto roots_re = roots.re();
-        const auto roots_im = roots.im();
-        const float tol2 = p.tolerance * p.tolerance;
+        /// Packs `count` pixels from the planes r, g and b into RGBA8 pixels with an alpha of 255. With the planes and
+        /// the row known not to overlap, the compiler turns the loop into byte shuffles of whole vectors.
+        void interleave_rgba(const std::uint8_t* __restrict r, const std::uint8_t* __restrict g, const std::uint8_t* __restrict b, std::uint8_t* __restrict pixels, const int count) noexcept
+        {
+#ifndef RUN_ON_CPU
+            ispc::interleave_rgba(r, g, b, count, count, 1, pixels, 4 * count);
+#else
+            for (int x = 0; x < count; ++x)
+            {
+                pixels[4 * x + 0] = r[x];
+                pixels[4 * x + 1] = g[x];
+                pixels[4 * x + 2] = b[x];
+                pixels[4 * x + 3] = 255;
+            }
+#endif
+        }
 
-        for (int py = 0; py < H; py++)
+        /// Caller-owned RGBA8 rows: columns [left, right) of rows [begin, end) are rendered into `out`, whose pixel
+        /// (0, 0) is pixel (left, begin) of the frame. A field render sets `field` instead and keeps the samples, laid
+        /// out the same way with fieldStride samples per row. It skips samples already filled, except
+        /// those stopped by a budget of resumeFrom iterations, which continue from where they stopped.
+        struct Target
         {
-            const float cy = p.ymin + dy * static_cast<float>(py);
+            ImageView out;
+            int left;
+            int right;
+            int begin;
+            int end;
+            FieldSample* field = nullptr;
+            std::size_t fieldStride = 0;
+            int resumeFrom = FieldSample::pending;
 
-            for (int px = 0; px < W; px++)
+            [[nodiscard]] std::uint8_t* pixel(const int x, const int y) const noexcept
             {
-                const float cx = p.xmin + dx * static_cast<float>(px);
-                Complex z{cx, cy};
+                return out.pixel(x - left, y - begin);
+            }
 
-                int iter = 0;
-                for (; iter < p.maxIter; ++iter)
+            [[nodiscard]] FieldSample* sample(const int x, const int y) const noexcept
+            {
+                return field + static_cast<std::size_t>(y - begin) * fieldStride + static_cast<std::size_t>(x - left);
+            }
+
+            /// False for samples a field render already holds
+            [[nodiscard]] bool pending(const int x, const int y) const noexcept
+            {
+                if (field == nullptr)
                 {
-                    // z^(n-1)
-                    const Complex zn1 = pow_int(z, p.degree - 1);
+                    return true;
+                }
+                const int iter = sample(x, y)->iter;
+                return iter == FieldSample::pending || iter == resumeFrom;
+            }
 
-                    // f(z) = z^n - 1
-                    const Complex zn = mul(zn1, z);
-                    const Complex fz{zn.re - 1.0f, zn.im};
+            /// The iteration a pending pixel starts at: 0 from z = its own start, or resumeFrom from its saved z
+            [[nodiscard]] int resume(const int x, const int y, float& zre, float& zim) const noexcept
+            {
+                if (field == nullptr || resumeFrom == FieldSample::pending)
+                {
+                    return 0;
+                }
+                const FieldSample& saved = *sample(x, y);
+                if (saved.iter != resumeFrom)
+                {
+                    return 0;
+                }
+                zre = saved.zre;
+                zim = saved.zim;
+                return resumeFrom;
+            }
+
+            void store(const RenderParams& p, const Complex z, const int iter, const float hue, const float bestDist2, const float tol2, const int x, const int y) const noexcept
+            {
+                if (field != nullptr)
+                {
+                    *sample(x, y) = {hue, bestDist2, iter, z.re, z.im};
+                    return;
+                }
+                shade_pixel(p, iter, hue, bestDist2, tol2, pixel(x, y));
+            }
+        };
+
+        /// Single precision pixel loop for one function family, step rule and classifier (see core/IterationKernel.hpp).
+        /// Everything is a template parameter, so each combination compiles to its own inlined loop.
+        template <typename Function, typename StepRule, typename Classifier>
+        void render_kernel(const RenderParams& p, const Function& f, const StepRule& step, const Classifier& classify, const Target& target)
+        {
+            const int W = p.width;
+            const int H = p.height;
+            const float dx = (p.xmax - p.xmin) / static_cast<float>(std::max(1, W - 1));
+            const float dy = (p.ymax - p.ymin) / static_cast<float>(std::max(1, H - 1));
+
+            const float tol2 = p.tolerance * p.tolerance;
+
+            for (int py = target.begin; py < target.end; py++)
+            {
+                const float cy = p.ymin + dy * static_cast<float>(py);
 
-                    if (abs2(fz) < tol2)
+                for (int px = target.left; px < target.right; px++)
+                {
+                    if (!target.pending(px, py))
                     {
-                        break;
+                        continue;
+                    }
+                    const float cx = p.xmin + dx * static_cast<float>(px);
+                    Complex z{cx, cy};
+
+                    int iter = target.resume(px, py, z.re, z.im);
+                    for (; iter < p.maxIter; ++iter)
+                    {
+                        Jet<StepRule::order> fz;
+                        Complex dz{};
+                        if (!f.template evaluate<StepRule::order>(z, tol2, fz) || !step(fz, dz))
+                        {
+                            break;
+                        }
+                        z.re -= dz.re;
+                        z.im -= dz.im;
                     }
 
-                    // f'(z) = n * z^(n-1)
-                    const Complex fpz{
-                        static_cast<float>(p.degree) * zn1.re,
-                        static_cast<float>(p.degree) * zn1.im
-                    };
+                    // Next we search the closest root
+                    float hue{};
+                    float bestDist2{};
+                    classify(z, hue, bestDist2);
+                    target.store(p, z, iter, hue, bestDist2, tol2, px, py);
+                }
+            }
+        }
+
+        /// Picks the step rule for --method once, outside the pixel loop
+        template <typename Function>
+        void render_function(const RenderParams& p, const RootsTable& roots, const Function& f, const Target& target)
+        {
+            const NearestRoot classify{roots};
+            switch (p.method)
+            {
+            case Method::HALLEY:
+                render_kernel(p, f, HalleyStep{}, classify, target);
+                break;
+            case Method::HOUSEHOLDER3:
+                render_kernel(p, f, Householder3Step{}, classify, target);
+                break;
+            case Method::SCHRODER:
+                render_kernel(p, f, SchroderStep{}, classify, target);
+                break;
+            case Method::NEWTON:
+            default:
+                render_kernel(p, f, NewtonStep{}, classify, target);
+                break;
+            }
+        }
+
+        /// Tiles of the target go to TileCertifier before any of their pixels is iterated. A tile whose pixels provably
+        /// all reach one root, at iteration counts that shade to the same colour, is filled with that colour; any other
+        /// tile is split into quarters down to min_tile pixels a side, and the rest is iterated pixel by pixel as usual.
+        /// The result is the image render_function() draws, only the certified tiles cost no per-pixel work.
+        template <typename Function>
+        class CertifiedTiles
+        {
+        public:
+            static constexpr int tile = 32;
+            static constexpr int min_tile = 8;
+
+            CertifiedTiles(const RenderParams& p, const RootsTable& roots, const Function& f, const std::span<const std::complex<double>> coefficients, const Target& target)
+                : m_p(p)
+                , m_roots(roots)
+                , m_f(f)
+                , m_target(target)
+                , m_certifier(coefficients, roots, p.maxIter, p.tolerance,
+                              std::is_same_v<Function, HornerFunction> ? TileCertifier::StopTest::NEWTON_STEP : TileCertifier::StopTest::RESIDUAL)
+                , m_dx((p.xmax - p.xmin) / static_cast<float>(std::max(1, p.width - 1)))
+                , m_dy((p.ymax - p.ymin) / static_cast<float>(std::max(1, p.height - 1)))
+            {
+            }
 
-                    const float denom2 = abs2(fpz);
-                    if (denom2 < 1e-12f)
+            void render()
+            {
+                for (int y = m_target.begin; y < m_target.end; y += tile)
+                {
+                    for (int x = m_target.left; x < m_target.right; x += tile)
                     {
-                        break;
+                        render(x, y, std::min(tile, m_target.right - x), std::min(tile, m_target.end - y));
                     }
+                }
+            }
 
-                    // f / f' = (a+ib)/(c+id) = ((ac+bd) + i(bc-ad)) / (c^2+d^2)
-                    const float a = fz.re;
-                    const float b = fz.im;
-                    const float c = fpz.re;
-                    const float d = fpz.im;
+        private:
+            void render(const int x, const int y, const int w, const int h)
+            {
+                if (fill(x, y, w, h))
+                {
+                    return;
+                }
+                if (w <= min_tile && h <= min_tile)
+                {
+                    render_function(m_p, m_roots, m_f, {m_target.out.sub(x - m_target.left, y - m_target.begin, w, h), x, x + w, y, y + h});
+                    return;
+                }
+                const int w0 = w > min_tile ? w / 2 : w;
+                const int h0 = h > min_tile ? h / 2 : h;
+                render(x, y, w0, h0);
+                if (w0 < w)
+                {
+                    render(x + w0, y, w - w0, h0);
+                }
+                if (h0 < h)
+                {
+                    render(x, y + h0, w0, h - h0);
+                    if (w0 < w)
+                    {
+                        render(x + w0, y + h0, w - w0, h - h0);
+                    }
+                }
+            }
 
-                    const float invDen = 1.0f / denom2;
-                    const Complex ratio{
-                        (a * c + b * d) * invDen,
-                        (b * c - a * d) * invDen
-                    };
+            /// Certifies the tile and fills it; false if it is not certified or its pixels would shade differently
+            bool fill(const int x, const int y, const int w, const int h)
+            {
+                // The kernel's float starting points of the tile's corner pixels bound those of all its pixels
+                const double x0 = m_p.xmin + m_dx * static_cast<float>(x);
+                const double x1 = m_p.xmin + m_dx * static_cast<float>(x + w - 1);
+                const double y0 = m_p.ymin + m_dy * static_cast<float>(y);
+                const double y1 = m_p.ymin + m_dy * static_cast<float>(y + h - 1);
+                const double radius = 0.5 * std::hypot(x1 - x0, y1 - y0) * (1.0 + 1e-12);
 
-                    // z = z - f/f'
-                    z.re -= ratio.re;
-                    z.im -= ratio.im;
+                const TileCertificate certificate = m_certifier.certify({0.5 * (x0 + x1), 0.5 * (y0 + y1)}, radius);
+                if (!certificate.certified)
+                {
+                    return false;
                 }
 
-                // Next we search the closest root
-                int bestIdx = 0;
-                float bestDist2 = std::numeric_limits<float>::max();
-                for (int k = 0; k < roots.size(); ++k)
+                const float tol2 = m_p.tolerance * m_p.tolerance;
+                const float hue = static_cast<float>(certificate.root) / static_cast<float>(m_roots.size());
+                std::array<std::uint8_t, 4> color{};
+                shade_pixel(m_p, certificate.firstIter, hue, 0.0f, tol2, color.data());
+                for (int iter = certificate.firstIter + 1; iter <= certificate.lastIter; ++iter)
                 {
-                    const float rx = roots_re[static_cast<std::size_t>(k)];
-                    const float ry = roots_im[static_cast<std::size_t>(k)];
-                    const float dxr = z.re - rx;
-                    const float dyr = z.im - ry;
-                    const float d2 = dxr * dxr + dyr * dyr;
+                    std::array<std::uint8_t, 4> other{};
+                    shade_pixel(m_p, iter, hue, 0.0f, tol2, other.data());
+                    if (other != color)
+                    {
+                        return false;
+                    }
+                }
 
-                    if (d2 < bestDist2)
+                for (int py = y; py < y + h; ++py)
+                {
+                    std::uint8_t* row = m_target.pixel(x, py);
+                    for (int px = 0; px < w; ++px)
                     {
-                        bestDist2 = d2;
-                        bestIdx = k;
+                        std::copy(color.begin(), color.end(), row + static_cast<std::size_t>(px) * 4u);
                     }
                 }
+                return true;
+            }
 
-                // Color: hue = root index / n, value = based on iterations
-                std::uint8_t R{}, G{}, B{};
-                if (iter != p.maxIter && bestDist2 < tol2)
+            const RenderParams& m_p;
+            const RootsTable& m_roots;
+            const Function& m_f;
+            const Target& m_target;
+            TileCertifier m_certifier;
+            float m_dx;
+            float m_dy;
+        };
+
+        /// True when p asks for certified tiles and its kernel has them: single precision Newton in the classic palette,
+        /// whose colour depends only on the root and the iteration count, for the unity and coefficient forms
+        [[nodiscard]] bool certifies_tiles(const RenderParams& p, const PreparedPolynomial& prepared) noexcept
+        {
+            if (!p.certifyTiles || p.precision != Precision::SINGLE || p.method != Method::NEWTON || p.colorMode != ColorMode::CLASSIC || prepared.roots.empty())
+            {
+                return false;
+            }
+            return (p.form == PolynomialForm::UNITY && p.degree >= 1 && p.degree <= TileCertifier::max_degree)
+                   || (p.form == PolynomialForm::COEFFICIENTS && prepared.polynomial.degree() <= TileCertifier::max_degree);
+        }
+
+        /// The coefficients the float Newton kernel iterates when p's tiles can be certified into an RGBA target (see
+        /// certifies_tiles()); empty otherwise
+        [[nodiscard]] std::vector<std::complex<double>> certifiable_coefficients(const RenderParams& p, const PreparedPolynomial& prepared, const Target& target)
+        {
+            std::vector<std::complex<double>> coefficients;
+            if (target.field != nullptr || !certifies_tiles(p, prepared))
+            {
+                return coefficients;
+            }
+            if (p.form == PolynomialForm::UNITY)
+            {
+                coefficients.assign(static_cast<std::size_t>(p.degree) + 1u, 0.0);
+                coefficients.front() = 1.0;
+                coefficients.back() = -1.0;
+            }
+            else
+            {
+                const auto re = prepared.polynomial.re();
+                const auto im = prepared.polynomial.im();
+                for (std::size_t k = 0; k < re.size(); ++k)
                 {
-                    const int numRoots = roots.size();
-                    switch (p.colorMode)
+                    coefficients.emplace_back(re[k], im[k]);
+                }
+            }
+            return coefficients;
+        }
+
+        /// Pixel loop for the batched families (see core/IterationKernel.hpp): batch_lanes pixels of a row advance
+        /// together. Lanes that have stopped keep being evaluated but are no longer stepped, like masked lanes of a SIMD
+        /// gang.
+        template <typename Family, typename StepRule>
+        void render_batched(const RenderParams& p, Family& family, const StepRule& step, const Target& target)
+        {
+            constexpr int order = StepRule::order;
+            constexpr int B = batch_lanes;
+
+            const int W = p.width;
+            const int H = p.height;
+            const float dx = (p.xmax - p.xmin) / static_cast<float>(std::max(1, W - 1));
+            const float dy = (p.ymax - p.ymin) / static_cast<float>(std::max(1, H - 1));
+
+            const float tol2 = p.tolerance * p.tolerance;
+
+            std::array<float, B> c_re{};
+            std::array<float, B> c_im{};
+            std::array<float, B> z_re{};
+            std::array<float, B> z_im{};
+            std::array<int, B> iters{};
+            std::array<bool, B> running{};
+
+            std::array<int, B> xs{};
+            std::array<int, B> first{};
+
+            for (int py = target.begin; py < target.end; py++)
+            {
+                const float cy = p.ymin + dy * static_cast<float>(py);
+
+                for (int next = target.left; next < target.right;)
+                {
+                    // The next pixels of the row still to compute; a short last batch repeats its final pixel in the
+                    // spare lanes
+                    int lanes = 0;
+                    for (; next < target.right && lanes < B; ++next)
+                    {
+                        if (target.pending(next, py))
+                        {
+                            xs[lanes++] = next;
+                        }
+                    }
+                    if (lanes == 0)
                     {
-                    case ColorMode::JEWELRY:
-                        shade_jewelry(iter, p.maxIter, bestIdx, numRoots, bestDist2, R, G, B);
-                        break;
-                    case ColorMode::NEON:
-                        shade_neon(iter, p.maxIter, bestDist2, R, G, B);
-                        break;
-                    case ColorMode::CLASSIC:
-                    default:
-                        shade_classic(iter, p.maxIter, bestIdx, numRoots, R, G, B);
                         break;
                     }
+                    for (int l = 0; l < B; ++l)
+                    {
+                        c_re[l] = p.xmin + dx * static_cast<float>(xs[std::min(l, lanes - 1)]);
+                        c_im[l] = cy;
+                        iters[l] = p.maxIter;
+                        running[l] = l < lanes;
+                    }
+                    family.start(c_re.data(), c_im.data(), z_re.data(), z_im.data());
+                    for (int l = 0; l < lanes; ++l)
+                    {
+                        first[l] = target.resume(xs[l], py, z_re[l], z_im[l]);
+                    }
+
+                    int live = lanes;
+                    for (int iter = 0; iter < p.maxIter && live > 0; ++iter)
+                    {
+                        const JetBatch<order>& f = family.evaluate(z_re.data(), z_im.data());
+
+                        for (int l = 0; l < B; ++l)
+                        {
+                            if (!running[l])
+                            {
+                                continue;
+                            }
+                            if (first[l] + iter == p.maxIter)
+                            {
+                                // A resumed lane used up its budget
+                                running[l] = false;
+                                --live;
+                                continue;
+                            }
+
+                            Jet<order> fz;
+                            for (int k = 0; k <= order; ++k)
+                            {
+                                fz[k] = {f.re[k][l], f.im[k][l]};
+                            }
+
+                            Complex dz{};
+                            if (newton_step_converged(fz[0], fz[1], tol2, family.degree()) || !step(fz, dz))
+                            {
+                                running[l] = false;
+                                iters[l] = first[l] + iter;
+                                --live;
+                                continue;
+                            }
+                            z_re[l] -= dz.re;
+                            z_im[l] -= dz.im;
+                        }
+                    }
+
+                    for (int l = 0; l < lanes; ++l)
+                    {
+                        float hue{};
+                        float bestDist2{};
+                        family.classify(l, {z_re[l], z_im[l]}, hue, bestDist2);
+                        target.store(p, {z_re[l], z_im[l]}, iters[l], hue, bestDist2, tol2, xs[l], py);
+                    }
+                }
+            }
+        }
+
+        template <template <int> typename Family, typename StepRule, typename... FamilyArgs>
+        void render_batched(const RenderParams& p, const StepRule& step, const Target& target, const FamilyArgs&... args)
+        {
+            Family<StepRule::order> family{args...};
+            render_batched(p, family, step, target);
+        }
+
+        void render_expression(const RenderParams& p, const PreparedPolynomial& prepared, const Target& target)
+        {
+            const Expression& expr = prepared.expression;
+            const RootsTable& roots = prepared.roots;
+            switch (p.method)
+            {
+            case Method::HALLEY:
+                render_batched<ExpressionFamily>(p, HalleyStep{}, target, expr, roots);
+                break;
+            case Method::HOUSEHOLDER3:
+                render_batched<ExpressionFamily>(p, Householder3Step{}, target, expr, roots);
+                break;
+            case Method::SCHRODER:
+                render_batched<ExpressionFamily>(p, SchroderStep{}, target, expr, roots);
+                break;
+            case Method::NEWTON:
+            default:
+                render_batched<ExpressionFamily>(p, NewtonStep{}, target, expr, roots);
+                break;
+            }
+        }
+
+        struct ComplexDD
+        {
+            DoubleDouble re;
+            DoubleDouble im;
+        };
+
+        [[nodiscard]] ComplexDD mul(const ComplexDD& a, const ComplexDD& b) noexcept
+        {
+            return {
+                a.re * b.re - a.im * b.im,
+                a.re * b.im + a.im * b.re
+            };
+        }
+
+        [[nodiscard]] ComplexDD pow_int(const ComplexDD& z, const int k) noexcept
+        {
+            ComplexDD res{DoubleDouble{1.0}, DoubleDouble{0.0}};
+            for (int i = 0; i < k; ++i)
+            {
+                res = mul(res, z);
+            }
+            return res;
+        }
+
+        [[nodiscard]] DoubleDouble bound_dd(const std::string& decimal, const float fallback)
+        {
+            return decimal.empty() ? DoubleDouble{static_cast<double>(fallback)} : DoubleDouble::parse(decimal);
+        }
+
+        /// Viewport origin and pixel step in double-double, shared by both backends.
+        struct ViewportDD
+        {
+            DoubleDouble x0;
+            DoubleDouble dx;
+            DoubleDouble y0;
+            DoubleDouble dy;
+        };
+
+        [[nodiscard]] ViewportDD viewport_dd(const RenderParams& p)
+        {
+            const DoubleDouble xmin = bound_dd(p.xminDecimal, p.xmin);
+            const DoubleDouble xmax = bound_dd(p.xmaxDecimal, p.xmax);
+            const DoubleDouble ymin = bound_dd(p.yminDecimal, p.ymin);
+            const DoubleDouble ymax = bound_dd(p.ymaxDecimal, p.ymax);
+
+            return {
+                xmin,
+                (xmax - xmin) / DoubleDouble{static_cast<double>(std::max(1, p.width - 1))},
+                ymin,
+                (ymax - ymin) / DoubleDouble{static_cast<double>(std::max(1, p.height - 1))}
+            };
+        }
+
+        void render_newton_cpu_dd(const RenderParams& p, const RootsTable& roots, const Target& target)
+        {
+            const ViewportDD view = viewport_dd(p);
+            const float tol2 = p.tolerance * p.tolerance;
+            const DoubleDouble degree{static_cast<double>(p.degree)};
+
+            for (int py = target.begin; py < target.end; py++)
+            {
+                const DoubleDouble cy = view.y0 + view.dy * DoubleDouble{static_cast<double>(py)};
+
+                for (int px = target.left; px < target.right; px++)
+                {
+                    if (!target.pending(px, py))
+                    {
+                        continue;
+                    }
+                    ComplexDD z{view.x0 + view.dx * DoubleDouble{static_cast<double>(px)}, cy};
+
+                    int iter = 0;
+                    for (; iter < p.maxIter; ++iter)
+                    {
+                        const ComplexDD zn1 = pow_int(z, p.degree - 1);
+                        const ComplexDD zn = mul(zn1, z);
+                        const ComplexDD fz{zn.re - DoubleDouble{1.0}, zn.im};
+
+                        // The convergence tests only need the leading parts
+                        if (fz.re.hi * fz.re.hi + fz.im.hi * fz.im.hi < static_cast<double>(tol2))
+                        {
+                            break;
+                        }
+
+                        const ComplexDD fpz{degree * zn1.re, degree * zn1.im};
+                        const DoubleDouble denom2 = fpz.re * fpz.re + fpz.im * fpz.im;
+                        if (denom2.hi < 1e-12)
+                        {
+                            break;
+                        }
+
+                        const DoubleDouble invDen = DoubleDouble{1.0} / denom2;
+                        z.re = z.re - (fz.re * fpz.re + fz.im * fpz.im) * invDen;
+                        z.im = z.im - (fz.im * fpz.re - fz.re * fpz.im) * invDen;
+                    }
+
+                    float hue{};
+                    float bestDist2{};
+                    const Complex zf{static_cast<float>(z.re.hi), static_cast<float>(z.im.hi)};
+                    NearestRoot{roots}(zf, hue, bestDist2);
+                    target.store(p, zf, iter, hue, bestDist2, tol2, px, py);
                 }
+            }
+        }
 
-                auto* pix = image.pixel(px, py);
-                pix[0] = R;
-                pix[1] = G;
-                pix[2] = B;
-                pix[3] = 255;
+        /// High-precision orbit of one reference point, rounded to double for the per-pixel delta iteration.
+        struct ReferenceOrbit
+        {
+            std::vector<double> re; // Z_k
+            std::vector<double> im;
+            std::vector<double> a_re; // Z_k^(1-n) / n
+            std::vector<double> a_im;
+            bool converged = false; // true when the last entry is a fixed point and may be reused indefinitely
+        };
+
+        /// Viewport origin and pixel step at whatever precision the decimal bounds call for.
+        struct ViewportBig
+        {
+            BigFloat x0;
+            BigFloat dx;
+            BigFloat y0;
+            BigFloat dy;
+        };
+
+        [[nodiscard]] ViewportBig viewport_big(const RenderParams& p)
+        {
+            // Enough limbs for every typed digit (log2(10) ~ 3.33 bits each) plus headroom for the orbit
+            std::size_t digits = 0;
+            for (const auto* decimal : {&p.xminDecimal, &p.xmaxDecimal, &p.yminDecimal, &p.ymaxDecimal})
+            {
+                digits = std::max(digits, decimal->size());
+            }
+            const int limbs = std::max(3, static_cast<int>((digits * 10 / 3 + 96) / 32) + 1);
+
+            const auto bound = [limbs](const std::string& decimal, const float fallback)
+            {
+                return decimal.empty() ? BigFloat{static_cast<double>(fallback), limbs} : BigFloat::parse(decimal, limbs);
+            };
+            const BigFloat xmin = bound(p.xminDecimal, p.xmin);
+            const BigFloat xmax = bound(p.xmaxDecimal, p.xmax);
+            const BigFloat ymin = bound(p.yminDecimal, p.ymin);
+            const BigFloat ymax = bound(p.ymaxDecimal, p.ymax);
+
+            return {
+                xmin,
+                (xmax - xmin) / BigFloat{static_cast<double>(std::max(1, p.width - 1)), limbs},
+                ymin,
+                (ymax - ymin) / BigFloat{static_cast<double>(std::max(1, p.height - 1)), limbs}
+            };
+        }
+
+        [[nodiscard]] ReferenceOrbit compute_reference_orbit(const ViewportBig& view, const int refX, const int refY, const int degree, const int maxIter)
+        {
+            const int limbs = view.x0.limbs();
+            BigFloat zre = view.x0 + view.dx * BigFloat{static_cast<double>(refX), limbs};
+            BigFloat zim = view.y0 + view.dy * BigFloat{static_cast<double>(refY), limbs};
+
+            // N(z) = z - (z^n - 1) / (n z^(n-1)) = ((n - 1) z + z^(1-n)) / n
+            const BigFloat n_minus_1{static_cast<double>(degree - 1), limbs};
+            const BigFloat inv_n = BigFloat{static_cast<double>(degree), limbs}.reciprocal();
+
+            ReferenceOrbit orbit;
+            orbit.re.reserve(static_cast<std::size_t>(maxIter) + 1);
+            orbit.im.reserve(static_cast<std::size_t>(maxIter) + 1);
+            orbit.a_re.reserve(static_cast<std::size_t>(maxIter) + 1);
+            orbit.a_im.reserve(static_cast<std::size_t>(maxIter) + 1);
+
+            for (int k = 0; k <= maxIter; ++k)
+            {
+                BigFloat wre{1.0, limbs};
+                BigFloat wim{limbs};
+                for (int i = 0; i < degree - 1; ++i)
+                {
+                    BigFloat t = wre * zre - wim * zim;
+                    wim = wre * zim + wim * zre;
+                    wre = std::move(t);
+                }
+
+                const BigFloat w_abs2 = wre * wre + wim * wim;
+                if (w_abs2.is_zero())
+                {
+                    // The reference sits on the pole of the Newton map; pixels past here have to rebase
+                    break;
+                }
+                const BigFloat inv_abs2 = w_abs2.reciprocal();
+                const BigFloat inv_re = wre * inv_abs2;
+                const BigFloat inv_im = -(wim * inv_abs2);
+
+                orbit.re.push_back(zre.to_double());
+                orbit.im.push_back(zim.to_double());
+                orbit.a_re.push_back((inv_re * inv_n).to_double());
+                orbit.a_im.push_back((inv_im * inv_n).to_double());
+
+                BigFloat next_re = (n_minus_1 * zre + inv_re) * inv_n;
+                BigFloat next_im = (n_minus_1 * zim + inv_im) * inv_n;
+                const bool fixed = next_re.to_double() == orbit.re.back() && next_im.to_double() == orbit.im.back();
+                zre = std::move(next_re);
+                zim = std::move(next_im);
+                if (fixed)
+                {
+                    orbit.converged = true;
+                    break;
+                }
+            }
+
+            return orbit;
+        }
+
+        /// Iterates one pixel as a delta from the reference orbit. Returns false when the pixel glitched (it passed
+        /// much closer to the pole than the reference did, so the delta lost its precision) and rebasing is off;
+        /// with rebasing on, the pixel continues in absolute coordinates from that point instead.
+        [[nodiscard]] bool perturb_pixel(const ReferenceOrbit& ref, double dre, double dim, const int degree, const int maxIter, const double tol2, const bool rebase, double& zre, double& zim, int& iter) noexcept
+        {
+            constexpr double glitch_ratio2 = 1.0e-6; // |Z + d| < 1e-3 |Z|
+            const int length = static_cast<int>(ref.re.size());
+            const double inv_n = 1.0 / static_cast<double>(degree);
+            const double keep = static_cast<double>(degree - 1) * inv_n;
+
+            bool absolute = false;
+            zre = dre;
+            zim = dim;
+            for (iter = 0; iter < maxIter; ++iter)
+            {
+                const int k = std::min(iter, length - 1);
+                const bool reference_valid = length > 0 && (iter < length || ref.converged);
+                if (!absolute)
+                {
+                    if (!reference_valid)
+                    {
+                        if (!rebase)
+                        {
+                            return false;
+                        }
+                        // The reference stopped on the pole z = 0, so the delta already is the absolute value
+                        absolute = true;
+                        zre = dre;
+                        zim = dim;
+                    }
+                    else
+                    {
+                        zre = ref.re[static_cast<std::size_t>(k)] + dre;
+                        zim = ref.im[static_cast<std::size_t>(k)] + dim;
+                    }
+                }
+
+                // z^(n-1), f(z) = z^n - 1 and f'(z) = n z^(n-1) at the pixel's full value
+                double pre = 1.0, pim = 0.0;
+                for (int i = 0; i < degree - 1; ++i)
+                {
+                    const double t = pre * zre - pim * zim;
+                    pim = pre * zim + pim * zre;
+                    pre = t;
+                }
+                const double fre = pre * zre - pim * zim - 1.0;
+                const double fim = pre * zim + pim * zre;
+                if (fre * fre + fim * fim < tol2)
+                {
+                    break;
+                }
+                const double cre = static_cast<double>(degree) * pre;
+                const double cim = static_cast<double>(degree) * pim;
+                const double denom2 = cre * cre + cim * cim;
+                if (denom2 < 1e-12)
+                {
+                    break;
+                }
+
+                if (!absolute)
+                {
+                    const double Zre = ref.re[static_cast<std::size_t>(k)];
+                    const double Zim = ref.im[static_cast<std::size_t>(k)];
+                    if (zre * zre + zim * zim < glitch_ratio2 * (Zre * Zre + Zim * Zim))
+                    {
+                        if (!rebase)
+                        {
+                            return false;
+                        }
+                        absolute = true;
+                    }
+                }
+
+                if (absolute)
+                {
+                    const double inv = 1.0 / denom2;
+                    const double rre = (fre * cre + fim * cim) * inv;
+                    const double rim = (fim * cre - fre * cim) * inv;
+                    zre -= rre;
+                    zim -= rim;
+                    continue;
+                }
+
+                // N(Z + d) - N(Z) = (n-1)/n d - Z^(1-n)/n * u S / (1 + u S), u = d / Z, S = sum_{j<n-1} (1 + u)^j,
+                // which never subtracts two nearly equal large numbers
+                const double Zre = ref.re[static_cast<std::size_t>(k)];
+                const double Zim = ref.im[static_cast<std::size_t>(k)];
+                const double invZ = 1.0 / (Zre * Zre + Zim * Zim);
+                const double ure = (dre * Zre + dim * Zim) * invZ;
+                const double uim = (dim * Zre - dre * Zim) * invZ;
+
+                double sre = 0.0, sim = 0.0;
+                double qre = 1.0, qim = 0.0;
+                for (int j = 0; j < degree - 1; ++j)
+                {
+                    sre += qre;
+                    sim += qim;
+                    const double t = qre * (1.0 + ure) - qim * uim;
+                    qim = qre * uim + qim * (1.0 + ure);
+                    qre = t;
+                }
+                const double usre = ure * sre - uim * sim;
+                const double usim = ure * sim + uim * sre;
+                const double q2 = qre * qre + qim * qim; // (1 + u)^(n-1) = 1 + u S
+                const double tre = (usre * qre + usim * qim) / q2;
+                const double tim = (usim * qre - usre * qim) / q2;
+
+                const double are = ref.a_re[static_cast<std::size_t>(k)];
+                const double aim = ref.a_im[static_cast<std::size_t>(k)];
+                dre = keep * dre - (are * tre - aim * tim);
+                dim = keep * dim - (are * tim + aim * tre);
+            }
+
+            if (!absolute && length > 0)
+            {
+                const int k = std::min(iter, length - 1);
+                zre = ref.re[static_cast<std::size_t>(k)] + dre;
+                zim = ref.im[static_cast<std::size_t>(k)] + dim;
+            }
+            return true;
+        }
+
+        /// Shared driver for perturbation rendering: the first reference sits at the image center, every further one
+        /// at a pixel that glitched against the previous references. `pass(orbit, refX, refY, dx, dy, onlyGlitched,
+        /// rebase)` renders the pixels flagged in `glitched` (or all of them) and flags the ones that glitch again.
+        template <typename Pass>
+        void render_perturbation(const RenderParams& p, std::vector<std::uint8_t>& glitched, Pass&& pass)
+        {
+            constexpr int max_references = 8;
+
+            const ViewportBig view = viewport_big(p);
+            const double dx = view.dx.to_double();
+            const double dy = view.dy.to_double();
+
+            int refX = p.width / 2;
+            int refY = p.height / 2;
+            glitched.assign(static_cast<std::size_t>(p.width) * static_cast<std::size_t>(p.height), std::uint8_t{0});
+
+            for (int reference = 0; reference < max_references; ++reference)
+            {
+                const ReferenceOrbit orbit = compute_reference_orbit(view, refX, refY, p.degree, p.maxIter);
+                const bool last = reference + 1 == max_references;
+                pass(orbit, refX, refY, dx, dy, reference > 0, last);
+
+                // Next reference: the median glitched pixel in scan order
+                std::vector<std::size_t> remaining;
+                for (std::size_t i = 0; i < glitched.size(); ++i)
+                {
+                    if (glitched[i] != 0)
+                    {
+                        remaining.push_back(i);
+                    }
+                }
+                if (remaining.empty() || last)
+                {
+                    break;
+                }
+                const std::size_t pick = remaining[remaining.size() / 2];
+                refX = static_cast<int>(pick % static_cast<std::size_t>(p.width));
+                refY = static_cast<int>(pick / static_cast<std::size_t>(p.width));
+            }
+        }
+
+        void render_newton_cpu_perturbation(const RenderParams& p, const RootsTable& roots, const Target& target)
+        {
+            const float tol2 = p.tolerance * p.tolerance;
+            std::vector<std::uint8_t> glitched;
+
+            render_perturbation(p, glitched, [&](const ReferenceOrbit& orbit, const int refX, const int refY, const double dx, const double dy, const bool onlyGlitched, const bool rebase)
+            {
+                for (int py = 0; py < p.height; py++)
+                {
+                    for (int px = 0; px < p.width; px++)
+                    {
+                        auto& flag = glitched[static_cast<std::size_t>(py) * static_cast<std::size_t>(p.width) + static_cast<std::size_t>(px)];
+                        if (onlyGlitched && flag == 0)
+                        {
+                            continue;
+                        }
+
+                        double zre{}, zim{};
+                        int iter{};
+                        const double d0re = static_cast<double>(px - refX) * dx;
+                        const double d0im = static_cast<double>(py - refY) * dy;
+                        if (!perturb_pixel(orbit, d0re, d0im, p.degree, p.maxIter, static_cast<double>(tol2), rebase, zre, zim, iter))
+                        {
+                            flag = 1;
+                            continue;
+                        }
+                        flag = 0;
+
+                        float hue{};
+                        float bestDist2{};
+                        const Complex zf{static_cast<float>(zre), static_cast<float>(zim)};
+                        NearestRoot{roots}(zf, hue, bestDist2);
+                        target.store(p, zf, iter, hue, bestDist2, tol2, px, py);
+                    }
+                }
+            });
+        }
+
+        /// True when p's family has the shape ParameterFamily and the ISPC kernel hold: a cubic or quartic in z, with one
+        /// coefficient of a per coefficient. Other families render nothing.
+        [[nodiscard]] bool renderable_family(const RenderParams& p) noexcept
+        {
+            const std::size_t terms = p.coefficients.size();
+            return (terms == 4 || terms == 5) && p.parameterCoefficients.size() == terms;
+        }
+
+        /// Picks the kernel for p's precision and form
+        void render_target(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, const Target& target)
+        {
+            const RootsTable& roots = prepared.roots;
+
+            if (p.precision == Precision::DOUBLE_DOUBLE)
+            {
+                render_newton_cpu_dd(p, roots, target);
+                return;
+            }
+            if (p.precision == Precision::PERTURBATION)
+            {
+                if (region == PixelRect::frame(p))
+                {
+                    render_newton_cpu_perturbation(p, roots, target);
+                }
+                return;
+            }
+
+            if (const auto coefficients = certifiable_coefficients(p, prepared, target); !coefficients.empty())
+            {
+                if (p.form == PolynomialForm::COEFFICIENTS)
+                {
+                    CertifiedTiles{p, roots, HornerFunction{prepared.polynomial}, coefficients, target}.render();
+                }
+                else
+                {
+                    CertifiedTiles{p, roots, AutoDiff{UnityFunction{p.degree}}, coefficients, target}.render();
+                }
+                return;
+            }
+
+            switch (p.form)
+            {
+            case PolynomialForm::COEFFICIENTS:
+                render_function(p, roots, HornerFunction{prepared.polynomial}, target);
+                break;
+            case PolynomialForm::ROOTS:
+                render_function(p, roots, RootsFunction{roots}, target);
+                break;
+            case PolynomialForm::EXPRESSION:
+                render_expression(p, prepared, target);
+                break;
+            case PolynomialForm::FAMILY:
+                if (!renderable_family(p))
+                {
+                    break;
+                }
+                render_batched<ParameterFamily>(p, NewtonStep{}, target, std::span<const std::complex<double>>{p.coefficients}, std::span<const std::complex<double>>{p.parameterCoefficients});
+                break;
+            case PolynomialForm::UNITY:
+            default:
+                render_function(p, roots, AutoDiff{UnityFunction{p.degree}}, target);
+                break;
+            }
+        }
+    }
+
+    PreparedPolynomial PreparedPolynomial::prepare(const RenderParams& p)
+    {
+        switch (p.form)
+        {
+        case PolynomialForm::COEFFICIENTS:
+            return prepare(p, RootsTable{Polynomial{p.coefficients}});
+        case PolynomialForm::EXPRESSION:
+        {
+            PreparedPolynomial prepared;
+            prepared.expression = Expression::parse(p.expression);
+            prepared.roots = RootsTable{Polynomial{prepared.expression.coefficients()}};
+            return prepared;
+        }
+        case PolynomialForm::ROOTS:
+            return prepare(p, RootsTable{p.roots});
+        case PolynomialForm::FAMILY:
+            // The roots differ from pixel to pixel; the renderer colours by the argument of the limit instead
+            return prepare(p, RootsTable{});
+        case PolynomialForm::UNITY:
+        default:
+            return prepare(p, RootsTable{p.degree});
+        }
+    }
+
+    PreparedPolynomial PreparedPolynomial::prepare(const RenderParams& p, RootsTable roots)
+    {
+        PreparedPolynomial prepared;
+        prepared.roots = std::move(roots);
+        if (p.form == PolynomialForm::COEFFICIENTS)
+        {
+            prepared.polynomial = Polynomial{p.coefficients};
+        }
+        else if (p.form == PolynomialForm::EXPRESSION)
+        {
+            prepared.expression = Expression::parse(p.expression);
+        }
+        else if (p.form == PolynomialForm::FAMILY && renderable_family(p))
+        {
+            for (std::size_t k = 0; k < p.coefficients.size(); ++k)
+            {
+                prepared.family.base_re.push_back(static_cast<float>(p.coefficients[k].real()));
+                prepared.family.base_im.push_back(static_cast<float>(p.coefficients[k].imag()));
+                prepared.family.slope_re.push_back(static_cast<float>(p.parameterCoefficients[k].real()));
+                prepared.family.slope_im.push_back(static_cast<float>(p.parameterCoefficients[k].imag()));
+            }
+        }
+        return prepared;
+    }
+
+    PixelRect PixelRect::frame(const RenderParams& p) noexcept
+    {
+        return {0, 0, p.width, p.height};
+    }
+
+    bool PixelRect::inside(const RenderParams& p) const noexcept
+    {
+        return width > 0 && height > 0 && x >= 0 && y >= 0 && x <= p.width - width && y <= p.height - height;
+    }
+
+    void render_newton_cpu(const RenderParams& p, const RootsTable& roots, Image& image)
+    {
+        if (p.width <= 0 || p.height <= 0 || image.width() != p.width || image.height() != p.height)
+            return;
+
+        render_newton_cpu(p, PreparedPolynomial::prepare(p, roots), PixelRect::frame(p), image.view());
+    }
+
+    void render_newton_cpu(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, const ImageView out)
+    {
+        if (!out.valid() || !region.inside(p) || out.width() != region.width || out.height() != region.height)
+            return;
+
+        if (p.colorMode == ColorMode::EQUALIZED)
+        {
+            // The ranks come from the whole frame
+            const std::size_t width = static_cast<std::size_t>(p.width);
+            std::vector<FieldSample> field(width * static_cast<std::size_t>(p.height));
+            std::vector<std::uint32_t> counts(equalization_bins, 0u);
+            std::vector<float> ranks(equalization_bins);
+            render_field_cpu(p, prepared, PixelRect::frame(p), field.data(), width);
+            histogram_field(p, PixelRect::frame(p), field.data(), width, counts);
+            equalize(counts, ranks);
+            shade_field(p, region, field.data() + static_cast<std::size_t>(region.y) * width + static_cast<std::size_t>(region.x), width, out, ranks);
+            return;
+        }
+        render_target(p, prepared, region, {out, region.x, region.x + region.width, region.y, region.y + region.height});
+    }
+
+    void render_field_cpu(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, FieldSample* field, const std::size_t fieldStride, const int resumeFrom)
+    {
+        if (field == nullptr || !region.inside(p) || fieldStride < static_cast<std::size_t>(region.width))
+            return;
+
+        // Samples saved at the current budget already ran out of it
+        const int resume = resumeFrom >= 0 && resumeFrom < p.maxIter ? resumeFrom : FieldSample::pending;
+        render_target(p, prepared, region, {{}, region.x, region.x + region.width, region.y, region.y + region.height, field, fieldStride, resume});
+    }
+
+    void histogram_field(const RenderParams& p, const PixelRect& region, const FieldSample* field, const std::size_t fieldStride, const std::span<std::uint32_t> counts) noexcept
+    {
+        if (field == nullptr || !region.inside(p) || counts.size() != static_cast<std::size_t>(equalization_bins))
+        {
+            return;
+        }
+
+        const float tol2 = p.tolerance * p.tolerance;
+        for (int y = 0; y < region.height; ++y)
+        {
+            const FieldSample* samples = field + static_cast<std::size_t>(y) * fieldStride;
+            for (int x = 0; x < region.width; ++x)
+            {
+                // Converged as shade_pixel() sees it
+                const FieldSample& sample = samples[x];
+                if (sample.iter >= 0 && sample.iter != p.maxIter && sample.dist2 < tol2)
+                {
+                    ++counts[static_cast<std::size_t>(equalization_bin(sample.iter, p.maxIter, sample.dist2))];
+                }
+            }
+        }
+    }
+
+    void equalize(const std::span<const std::uint32_t> counts, const std::span<float> ranks) noexcept
+    {
+        if (counts.size() != ranks.size())
+        {
+            return;
+        }
+
+        std::uint64_t total = 0;
+        for (const std::uint32_t count : counts)
+        {
+            total += count;
+        }
+        const double scale = total > 0 ? 1.0 / static_cast<double>(total) : 0.0;
+        std::uint64_t below = 0;
+        for (std::size_t bin = 0; bin < counts.size(); ++bin)
+        {
+            ranks[bin] = static_cast<float>((static_cast<double>(below) + 0.5 * static_cast<double>(counts[bin])) * scale);
+            below += counts[bin];
+        }
+    }
+
+    void shade_field(const RenderParams& p, const PixelRect& region, const FieldSample* field, const std::size_t fieldStride, const ImageView out, const std::span<const float> ranks) noexcept
+    {
+        if (field == nullptr || !out.valid() || !region.inside(p) || out.width() != region.width || out.height() != region.height)
+            return;
+
+        const float tol2 = p.tolerance * p.tolerance;
+        if (p.colorMode != ColorMode::NEON || !p.fastShading)
+        {
+            for (int y = 0; y < region.height; ++y)
+            {
+                const FieldSample* samples = field + static_cast<std::size_t>(y) * fieldStride;
+                std::uint8_t* pixels = out.row(y);
+                for (int x = 0; x < region.width; ++x)
+                {
+                    shade_pixel(p, samples[x].iter, samples[x].hue, samples[x].dist2, tol2, pixels + static_cast<std::size_t>(x) * 4u, ranks);
+                }
+            }
+            return;
+        }
+
+        // The one palette whose row loop vectorizes (see shade_row_neon_fast()): runs of a row are shaded into planes on
+        // the stack, small enough to stay in L1, and interleaved into the pixels in one pass. For the others the extra
+        // pass would cost more than the planes save.
+        constexpr int run = 256;
+        alignas(64) std::array<std::uint8_t, 3 * run> planes;
+        for (int y = 0; y < region.height; ++y)
+        {
+            const FieldSample* samples = field + static_cast<std::size_t>(y) * fieldStride;
+            for (int x = 0; x < region.width; x += run)
+            {
+                const int count = std::min(run, region.width - x);
+                std::uint8_t* r = planes.data();
+                shade_row_neon_fast(samples + x, count, p.maxIter, tol2, r, r + run, r + 2 * run);
+                interleave_rgba(r, r + run, r + 2 * run, out.pixel(x, y), count);
             }
         }
     }
 
 #ifndef RUN_ON_CPU
-    void render_newton_ispc(const Arguments& p, const RootsTable& roots, Image& image)
+    namespace
+    {
+        /// The kernels' colorMode argument: the palette, plus fast_shading_flag for --fast-math-shading
+        [[nodiscard]] int ispc_color_mode(const RenderParams& p) noexcept
+        {
+            constexpr int fast_shading_flag = 8;
+            return static_cast<int>(p.colorMode) | (p.fastShading ? fast_shading_flag : 0);
+        }
+    }
+
+    void render_newton_ispc(const RenderParams& p, const RootsTable& roots, Image& image)
     {
-        if (p.width <= 0 || p.height <= 0 || image.width() != p.width || image.height() != p.height || roots.empty())
+        if (p.width <= 0 || p.height <= 0 || image.width() != p.width || image.height() != p.height)
         {
             return;
         }
 
+        render_newton_ispc(p, PreparedPolynomial::prepare(p, roots), image.view());
+    }
+
+    void render_newton_ispc(const RenderParams& p, const PreparedPolynomial& prepared, const ImageView out)
+    {
+        if (!out.valid() || out.width() != p.width || out.height() != p.height || out.stride() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        {
+            return;
+        }
+        if (p.colorMode == ColorMode::EQUALIZED)
+        {
+            // Ranking needs the samples of the whole frame, which the ISPC kernels do not keep
+            render_newton_cpu(p, prepared, PixelRect::frame(p), out);
+            return;
+        }
+        if (p.precision != Precision::PERTURBATION)
+        {
+            static_cast<void>(render_newton_ispc_region(p, prepared, PixelRect::frame(p), out));
+            return;
+        }
+
+        const RootsTable& roots = prepared.roots;
+        if (roots.empty())
+        {
+            return;
+        }
+
+        const auto roots_re = roots.re();
+        const auto roots_im = roots.im();
+        const int stride = static_cast<int>(out.stride());
+        std::vector<std::uint8_t> glitched;
+        render_perturbation(p, glitched, [&](const ReferenceOrbit& orbit, const int refX, const int refY, const double dx, const double dy, const bool onlyGlitched, const bool rebase)
+        {
+            ispc::newton_fractal_perturb(
+                p.width,
+                p.height,
+                refX,
+                refY,
+                dx,
+                dy,
+                orbit.re.data(),
+                orbit.im.data(),
+                orbit.a_re.data(),
+                orbit.a_im.data(),
+                static_cast<int>(orbit.re.size()),
+                orbit.converged,
+                p.degree,
+                p.maxIter,
+                p.tolerance,
+                roots_re.data(),
+                roots_im.data(),
+                roots.size(),
+                ispc_color_mode(p),
+                glitched.data(),
+                onlyGlitched,
+                rebase,
+                out.data(),
+                stride
+            );
+        });
+    }
+
+    bool render_newton_ispc_region(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, const ImageView out)
+    {
+        if (p.precision == Precision::PERTURBATION || p.colorMode == ColorMode::EQUALIZED)
+        {
+            return false;
+        }
+        if (!out.valid() || !region.inside(p) || out.width() != region.width || out.height() != region.height
+            || out.stride() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        {
+            return true;
+        }
+        if (certifies_tiles(p, prepared))
+        {
+            // The tile certifier bounds the CPU kernel's rounding, so certified renders run on it
+            render_newton_cpu(p, prepared, region, out);
+            return true;
+        }
+        const int stride = static_cast<int>(out.stride());
+
+        if (p.form == PolynomialForm::FAMILY)
+        {
+            const auto& family = prepared.family;
+            if (!renderable_family(p) || family.base_re.size() != p.coefficients.size())
+            {
+                return true;
+            }
+            ispc::newton_fractal_family_region(
+                p.width,
+                p.height,
+                region.x,
+                region.y,
+                region.width,
+                region.height,
+                p.xmin,
+                p.xmax,
+                p.ymin,
+                p.ymax,
+                family.base_re.data(),
+                family.base_im.data(),
+                family.slope_re.data(),
+                family.slope_im.data(),
+                static_cast<int>(family.base_re.size()) - 1,
+                p.maxIter,
+                p.tolerance,
+                ispc_color_mode(p),
+                out.data(),
+                stride
+            );
+            return true;
+        }
+
+        const RootsTable& roots = prepared.roots;
+        if (roots.empty())
+        {
+            return true;
+        }
+
         const auto roots_re = roots.re();
         const auto roots_im = roots.im();
 
-        ispc::newton_fractal(
+        if (p.precision == Precision::DOUBLE_DOUBLE)
+        {
+            const ViewportDD view = viewport_dd(p);
+            ispc::newton_fractal_dd_region(
+                p.width,
+                p.height,
+                region.x,
+                region.y,
+                region.width,
+                region.height,
+                view.x0.hi,
+                view.x0.lo,
+                view.dx.hi,
+                view.dx.lo,
+                view.y0.hi,
+                view.y0.lo,
+                view.dy.hi,
+                view.dy.lo,
+                p.degree,
+                p.maxIter,
+                p.tolerance,
+                roots_re.data(),
+                roots_im.data(),
+                roots.size(),
+                ispc_color_mode(p),
+                out.data(),
+                stride
+            );
+            return true;
+        }
+
+        if (p.form == PolynomialForm::COEFFICIENTS)
+        {
+            const Polynomial& poly = prepared.polynomial;
+            ispc::newton_fractal_poly_region(
+                p.width,
+                p.height,
+                region.x,
+                region.y,
+                region.width,
+                region.height,
+                p.xmin,
+                p.xmax,
+                p.ymin,
+                p.ymax,
+                poly.re().data(),
+                poly.im().data(),
+                poly.derivative_re().data(),
+                poly.derivative_im().data(),
+                poly.degree(),
+                p.maxIter,
+                p.tolerance,
+                static_cast<int>(p.method),
+                roots_re.data(),
+                roots_im.data(),
+                roots.size(),
+                ispc_color_mode(p),
+                out.data(),
+                stride
+            );
+            return true;
+        }
+
+        if (p.form == PolynomialForm::ROOTS)
+        {
+            ispc::newton_fractal_roots_region(
+                p.width,
+                p.height,
+                region.x,
+                region.y,
+                region.width,
+                region.height,
+                p.xmin,
+                p.xmax,
+                p.ymin,
+                p.ymax,
+                p.maxIter,
+                p.tolerance,
+                static_cast<int>(p.method),
+                roots_re.data(),
+                roots_im.data(),
+                roots.size(),
+                ispc_color_mode(p),
+                out.data(),
+                stride
+            );
+            return true;
+        }
+
+        if (p.form == PolynomialForm::EXPRESSION)
+        {
+            const Expression& expr = prepared.expression;
+            static_assert(sizeof(Expression::Instruction) == 4 && Expression::max_registers == 32, "mirrored by EXPR_* in Newton.ispc");
+            ispc::newton_fractal_expr_region(
+                p.width,
+                p.height,
+                region.x,
+                region.y,
+                region.width,
+                region.height,
+                p.xmin,
+                p.xmax,
+                p.ymin,
+                p.ymax,
+                reinterpret_cast<const std::uint8_t*>(expr.code().data()),
+                static_cast<int>(expr.code().size()),
+                expr.constants_re().data(),
+                expr.constants_im().data(),
+                static_cast<int>(expr.coefficients().size()) - 1,
+                p.maxIter,
+                p.tolerance,
+                static_cast<int>(p.method),
+                roots_re.data(),
+                roots_im.data(),
+                roots.size(),
+                ispc_color_mode(p),
+                out.data(),
+                stride
+            );
+            return true;
+        }
+
+        ispc::newton_fractal_region(
             p.width,
             p.height,
+            region.x,
+            region.y,
+            region.width,
+            region.height,
             p.xmin,
             p.xmax,
             p.ymin,
@@ -335,12 +1638,15 @@ namespace nfract
             p.degree,
             p.maxIter,
             p.tolerance,
+            static_cast<int>(p.method),
             roots_re.data(),
             roots_im.data(),
             roots.size(),
-            static_cast<int>(p.colorMode),
-            image.data()
+            ispc_color_mode(p),
+            out.data(),
+            stride
         );
+        return true;
     }
 
 #endif
@@ -0,0 +1,193 @@
+#include "core/RenderState.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <sstream>
+#include <stdexcept>
+
+namespace nfract
+{
+    namespace
+    {
+        constexpr char tag[] = "nfract-state-1\n";
+
+        /// Everything the samples depend on apart from the budget, floats written exactly
+        [[nodiscard]] std::string field_key(const RenderParams& p)
+        {
+            std::ostringstream key;
+            key << std::hexfloat;
+            key << p.width << ' ' << p.height << ' ' << p.degree << ' ' << static_cast<int>(p.form) << ' ' << static_cast<int>(p.method) << ' '
+                << static_cast<int>(p.precision) << ' ' << p.tolerance << ' ' << p.xmin << ' ' << p.xmax << ' ' << p.ymin << ' ' << p.ymax;
+            for (const auto* list : {&p.coefficients, &p.parameterCoefficients, &p.roots})
+            {
+                key << " [";
+                for (const auto& c : *list)
+                {
+                    key << ' ' << c.real() << ' ' << c.imag();
+                }
+                key << " ]";
+            }
+            key << " '" << p.expression << "' '" << p.xminDecimal << "' '" << p.xmaxDecimal << "' '" << p.yminDecimal << "' '" << p.ymaxDecimal << "'";
+            return key.str();
+        }
+
+        template <typename T>
+        void write(std::ostream& out, const T& value)
+        {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        [[nodiscard]] T read(std::istream& in)
+        {
+            T value{};
+            if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            {
+                throw std::runtime_error("Truncated state file");
+            }
+            return value;
+        }
+
+        /// Samples are stored without their z unless they ran out of iterations
+        struct StoredSample
+        {
+            float hue;
+            float dist2;
+            std::int32_t iter;
+        };
+
+        struct StoredStop
+        {
+            std::uint32_t index;
+            float zre;
+            float zim;
+        };
+    }
+
+    RenderState::RenderState(const RenderParams& p, std::vector<FieldSample> field) :
+        m_key(field_key(p)),
+        m_maxIter(p.maxIter),
+        m_field(std::move(field))
+    {
+    }
+
+    RenderState RenderState::load(const std::filesystem::path& path)
+    {
+        std::ifstream in{path, std::ios::binary};
+        if (!in)
+        {
+            throw std::runtime_error("Cannot open state file: '" + path.string() + "'");
+        }
+        std::string header(sizeof(tag) - 1, '\0');
+        if (!in.read(header.data(), static_cast<std::streamsize>(header.size())) || header != tag)
+        {
+            throw std::runtime_error("Not an nfract state file: '" + path.string() + "'");
+        }
+
+        RenderState state;
+        state.m_key.resize(read<std::uint32_t>(in));
+        if (!in.read(state.m_key.data(), static_cast<std::streamsize>(state.m_key.size())))
+        {
+            throw std::runtime_error("Truncated state file");
+        }
+        state.m_maxIter = read<std::int32_t>(in);
+        const auto samples = read<std::uint64_t>(in);
+        const auto stops = read<std::uint64_t>(in);
+        if (samples > std::uint64_t{UINT32_MAX} || stops > samples)
+        {
+            throw std::runtime_error("Corrupt state file: '" + path.string() + "'");
+        }
+
+        // The key starts with the size of the frame, which must hold exactly the stored samples
+        std::istringstream frame{state.m_key};
+        std::int64_t width = 0;
+        std::int64_t height = 0;
+        if (!(frame >> width >> height) || width <= 0 || height <= 0 || static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height) != samples)
+        {
+            throw std::runtime_error("Corrupt state file: '" + path.string() + "'");
+        }
+
+        state.m_field.resize(static_cast<std::size_t>(samples));
+        for (FieldSample& sample : state.m_field)
+        {
+            const auto stored = read<StoredSample>(in);
+            sample = {stored.hue, stored.dist2, stored.iter};
+        }
+        for (std::uint64_t i = 0; i < stops; ++i)
+        {
+            const auto stop = read<StoredStop>(in);
+            if (stop.index >= samples)
+            {
+                throw std::runtime_error("Corrupt state file: '" + path.string() + "'");
+            }
+            state.m_field[stop.index].zre = stop.zre;
+            state.m_field[stop.index].zim = stop.zim;
+        }
+        return state;
+    }
+
+    bool RenderState::save(const std::filesystem::path& path) const noexcept
+    {
+        try
+        {
+            std::ofstream out{path, std::ios::binary | std::ios::trunc};
+            if (!out)
+            {
+                return false;
+            }
+            out.write(tag, sizeof(tag) - 1);
+            write(out, static_cast<std::uint32_t>(m_key.size()));
+            out.write(m_key.data(), static_cast<std::streamsize>(m_key.size()));
+            write(out, static_cast<std::int32_t>(m_maxIter));
+            write(out, static_cast<std::uint64_t>(m_field.size()));
+            write(out, static_cast<std::uint64_t>(unconverged()));
+            for (const FieldSample& sample : m_field)
+            {
+                write(out, StoredSample{sample.hue, sample.dist2, sample.iter});
+            }
+            for (std::size_t i = 0; i < m_field.size(); ++i)
+            {
+                if (m_field[i].iter == m_maxIter)
+                {
+                    write(out, StoredStop{static_cast<std::uint32_t>(i), m_field[i].zre, m_field[i].zim});
+                }
+            }
+            return static_cast<bool>(out.flush());
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    bool RenderState::resumable_by(const RenderParams& p) const
+    {
+        if (p.width <= 0 || p.height <= 0 || m_field.size() != static_cast<std::size_t>(p.width) * static_cast<std::size_t>(p.height))
+        {
+            return false;
+        }
+        return p.maxIter >= m_maxIter && field_key(p) == m_key;
+    }
+
+    int RenderState::max_iter() const noexcept
+    {
+        return m_maxIter;
+    }
+
+    int RenderState::unconverged() const noexcept
+    {
+        return static_cast<int>(std::ranges::count_if(m_field, [this](const FieldSample& sample) { return sample.iter == m_maxIter; }));
+    }
+
+    std::vector<FieldSample>& RenderState::field() noexcept
+    {
+        return m_field;
+    }
+
+    const std::vector<FieldSample>& RenderState::field() const noexcept
+    {
+        return m_field;
+    }
+}
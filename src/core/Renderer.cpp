@@ -0,0 +1,425 @@
+#include "core/Renderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace nfract
+{
+    Renderer::Renderer(const int threads) :
+        m_pool(threads)
+    {
+        m_cache.reserve(cache_capacity);
+    }
+
+    ThreadPool& Renderer::pool() noexcept
+    {
+        return m_pool;
+    }
+
+    bool Renderer::CacheEntry::matches(const RenderParams& p) const noexcept
+    {
+        if (form != p.form)
+        {
+            return false;
+        }
+        switch (form)
+        {
+        case PolynomialForm::COEFFICIENTS:
+            return coefficients == p.coefficients;
+        case PolynomialForm::ROOTS:
+            return roots == p.roots;
+        case PolynomialForm::EXPRESSION:
+            return expression == p.expression;
+        case PolynomialForm::FAMILY:
+            return coefficients == p.coefficients && parameterCoefficients == p.parameterCoefficients;
+        case PolynomialForm::UNITY:
+        default:
+            return degree == p.degree;
+        }
+    }
+
+    std::shared_ptr<const PreparedPolynomial> Renderer::prepared(const RenderParams& p)
+    {
+        {
+            const std::lock_guard lock{m_mutex};
+            const auto hit = std::ranges::find_if(m_cache, [&p](const CacheEntry& entry) { return entry.matches(p); });
+            if (hit != m_cache.end())
+            {
+                std::rotate(hit, hit + 1, m_cache.end());
+                return m_cache.back().prepared;
+            }
+        }
+
+        // Root finding can take a while; concurrent misses on the same polynomial just prepare it twice
+        auto prepared = std::make_shared<const PreparedPolynomial>(PreparedPolynomial::prepare(p));
+
+        const std::lock_guard lock{m_mutex};
+        if (m_cache.size() == cache_capacity)
+        {
+            m_cache.erase(m_cache.begin());
+        }
+        m_cache.push_back({p.form, p.degree, p.coefficients, p.parameterCoefficients, p.roots, p.expression, prepared});
+        return prepared;
+    }
+
+    void Renderer::render(const RenderParams& p, std::uint8_t* out, const std::size_t stride)
+    {
+        if (p.width <= 0 || p.height <= 0 || out == nullptr || stride < static_cast<std::size_t>(p.width) * 4u)
+        {
+            return;
+        }
+        const auto prepared_polynomial = prepared(p);
+        render(p, *prepared_polynomial, ImageView{out, p.width, p.height, stride});
+    }
+
+    void Renderer::render(const RenderParams& p, const PreparedPolynomial& prepared, const ImageView out)
+    {
+        static_cast<void>(render_tiles(p, prepared, PixelRect::frame(p), out, nullptr));
+    }
+
+    void Renderer::render(const RenderParams& p, const PixelRect& region, const ImageView out)
+    {
+        if (!out.valid() || !region.inside(p) || out.width() != region.width || out.height() != region.height)
+        {
+            return;
+        }
+        const auto prepared_polynomial = prepared(p);
+        static_cast<void>(render_tiles(p, *prepared_polynomial, region, out, nullptr));
+    }
+
+    RenderStatus Renderer::render_tiles(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, const ImageView out, RenderProgress* progress)
+    {
+        if (!out.valid() || !region.inside(p) || out.width() != region.width || out.height() != region.height)
+        {
+            return RenderStatus::COMPLETED;
+        }
+
+        if (p.colorMode == ColorMode::EQUALIZED)
+        {
+            return render_equalized(p, prepared, region, out, progress);
+        }
+
+        // Tiles run in parallel but report in any order, so only the counters are shared
+        const auto run_tile = [progress](const auto& tile)
+        {
+            if (progress != nullptr && progress->cancelled.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            tile();
+            if (progress != nullptr)
+            {
+                progress->tilesDone.fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+        const auto status = [progress]
+        {
+            return progress != nullptr && progress->cancelled.load(std::memory_order_relaxed) ? RenderStatus::CANCELLED : RenderStatus::COMPLETED;
+        };
+
+        if (p.precision == Precision::PERTURBATION)
+        {
+            // The references are chosen from the glitches of the whole image, so it is a single tile
+            if (progress != nullptr)
+            {
+                progress->tilesTotal.store(1, std::memory_order_relaxed);
+            }
+            run_tile([&]
+            {
+                if (region != PixelRect::frame(p))
+                {
+                    render_staged(p, prepared, region, out);
+                    return;
+                }
+#ifdef RUN_ON_CPU
+                render_newton_cpu(p, prepared, region, out);
+#else
+                render_newton_ispc(p, prepared, out);
+#endif
+            });
+            return status();
+        }
+        const int bands = (region.height + band_rows - 1) / band_rows;
+        if (progress != nullptr)
+        {
+            progress->tilesTotal.store(bands, std::memory_order_relaxed);
+        }
+        m_pool.parallel_for(bands, [&](const int band)
+        {
+            const int top = band * band_rows;
+            const PixelRect rows{region.x, region.y + top, region.width, std::min(band_rows, region.height - top)};
+            const ImageView band_out = out.sub(0, top, rows.width, rows.height);
+#ifdef RUN_ON_CPU
+            run_tile([&] { render_newton_cpu(p, prepared, rows, band_out); });
+#else
+            run_tile([&] { static_cast<void>(render_newton_ispc_region(p, prepared, rows, band_out)); });
+#endif
+        });
+        return status();
+    }
+
+    void Renderer::render_staged(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, const ImageView out)
+    {
+        std::vector<std::uint8_t> staging;
+        {
+            const std::lock_guard lock{m_mutex};
+            if (!m_staging.empty())
+            {
+                staging = std::move(m_staging.back());
+                m_staging.pop_back();
+            }
+        }
+
+        staging.resize(static_cast<std::size_t>(p.width) * static_cast<std::size_t>(p.height) * 4u);
+        const ImageView frame{staging.data(), p.width, p.height};
+#ifdef RUN_ON_CPU
+        render_newton_cpu(p, prepared, PixelRect::frame(p), frame);
+#else
+        render_newton_ispc(p, prepared, frame);
+#endif
+        for (int y = 0; y < region.height; ++y)
+        {
+            std::memcpy(out.row(y), frame.pixel(region.x, region.y + y), out.row_bytes());
+        }
+
+        const std::lock_guard lock{m_mutex};
+        m_staging.push_back(std::move(staging));
+    }
+
+    Renderer::Equalization Renderer::acquire_equalization()
+    {
+        const std::lock_guard lock{m_mutex};
+        if (m_equalization.empty())
+        {
+            return {};
+        }
+        Equalization buffers = std::move(m_equalization.back());
+        m_equalization.pop_back();
+        return buffers;
+    }
+
+    void Renderer::release_equalization(Equalization&& buffers)
+    {
+        const std::lock_guard lock{m_mutex};
+        m_equalization.push_back(std::move(buffers));
+    }
+
+    RenderStatus Renderer::render_equalized(const RenderParams& p, const PreparedPolynomial& prepared, const PixelRect& region, const ImageView out, RenderProgress* progress)
+    {
+        Equalization buffers = acquire_equalization();
+        const std::size_t width = static_cast<std::size_t>(p.width);
+        buffers.field.assign(width * static_cast<std::size_t>(p.height), FieldSample{});
+
+        // Perturbation picks its references from the whole frame, so it is a single band
+        const int bands = p.precision == Precision::PERTURBATION ? 1 : (p.height + band_rows - 1) / band_rows;
+        if (progress != nullptr)
+        {
+            progress->tilesTotal.store(bands, std::memory_order_relaxed);
+        }
+        m_pool.parallel_for(bands, [&](const int band)
+        {
+            if (progress != nullptr && progress->cancelled.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            const int top = band * band_rows;
+            const PixelRect rows = bands == 1 ? PixelRect::frame(p) : PixelRect{0, top, p.width, std::min(band_rows, p.height - top)};
+            render_field_cpu(p, prepared, rows, buffers.field.data() + static_cast<std::size_t>(rows.y) * width, width);
+            if (progress != nullptr)
+            {
+                progress->tilesDone.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        const bool cancelled = progress != nullptr && progress->cancelled.load(std::memory_order_relaxed);
+        if (!cancelled)
+        {
+            shade_bands(p, region, buffers.field.data(), width, out, buffers);
+        }
+        release_equalization(std::move(buffers));
+        return cancelled ? RenderStatus::CANCELLED : RenderStatus::COMPLETED;
+    }
+
+    void Renderer::shade_field(const RenderParams& p, const PixelRect& region, const FieldSample* field, const std::size_t fieldStride, const ImageView out)
+    {
+        if (field == nullptr || !out.valid() || !region.inside(p) || out.width() != region.width || out.height() != region.height || fieldStride < static_cast<std::size_t>(p.width))
+        {
+            return;
+        }
+        Equalization buffers = acquire_equalization();
+        shade_bands(p, region, field, fieldStride, out, buffers);
+        release_equalization(std::move(buffers));
+    }
+
+    void Renderer::shade_bands(const RenderParams& p, const PixelRect& region, const FieldSample* field, const std::size_t fieldStride, const ImageView out, Equalization& buffers)
+    {
+        buffers.ranks.clear();
+        if (p.colorMode == ColorMode::EQUALIZED)
+        {
+            // One histogram per thread over a slab of rows, then each thread sums one range of bins over all of them
+            const int slabs = std::min(m_pool.concurrency(), p.height);
+            const auto bins = static_cast<std::size_t>(equalization_bins);
+            buffers.counts.assign(static_cast<std::size_t>(slabs) * bins, 0u);
+            const std::span counts{buffers.counts};
+            m_pool.parallel_for(slabs, [&](const int slab)
+            {
+                const int top = p.height * slab / slabs;
+                const int bottom = p.height * (slab + 1) / slabs;
+                histogram_field(p, {0, top, p.width, bottom - top}, field + static_cast<std::size_t>(top) * fieldStride, fieldStride,
+                                counts.subspan(static_cast<std::size_t>(slab) * bins, bins));
+            });
+            m_pool.parallel_for(slabs, [&](const int range)
+            {
+                const std::size_t first = bins * static_cast<std::size_t>(range) / static_cast<std::size_t>(slabs);
+                const std::size_t last = bins * static_cast<std::size_t>(range + 1) / static_cast<std::size_t>(slabs);
+                for (int slab = 1; slab < slabs; ++slab)
+                {
+                    const std::uint32_t* from = counts.data() + static_cast<std::size_t>(slab) * bins;
+                    for (std::size_t bin = first; bin < last; ++bin)
+                    {
+                        counts[bin] += from[bin];
+                    }
+                }
+            });
+            buffers.ranks.resize(bins);
+            equalize(counts.first(bins), buffers.ranks);
+        }
+
+        const FieldSample* origin = field + static_cast<std::size_t>(region.y) * fieldStride + static_cast<std::size_t>(region.x);
+        const int bands = (region.height + band_rows - 1) / band_rows;
+        m_pool.parallel_for(bands, [&](const int band)
+        {
+            const int top = band * band_rows;
+            const PixelRect rows{region.x, region.y + top, region.width, std::min(band_rows, region.height - top)};
+            nfract::shade_field(p, rows, origin + static_cast<std::size_t>(top) * fieldStride, fieldStride, out.sub(0, top, rows.width, rows.height), buffers.ranks);
+        });
+    }
+
+    void Renderer::render(const RenderParams& p, Image& image)
+    {
+        if (image.width() != p.width || image.height() != p.height)
+        {
+            return;
+        }
+        render(p, image.data(), image.stride());
+    }
+
+    void Renderer::render(const RenderParams& p, const PixelRect& region, Image& image)
+    {
+        if (image.width() != p.width || image.height() != p.height || !region.inside(p))
+        {
+            return;
+        }
+        render(p, region, image.view().sub(region.x, region.y, region.width, region.height));
+    }
+
+    void Renderer::render_field(const RenderParams& p, FieldSample* field, const std::size_t fieldStride, const int resumeFrom)
+    {
+        if (p.width <= 0 || p.height <= 0 || field == nullptr || fieldStride < static_cast<std::size_t>(p.width))
+        {
+            return;
+        }
+        const auto prepared_polynomial = prepared(p);
+        if (p.precision == Precision::PERTURBATION)
+        {
+            render_field_cpu(p, *prepared_polynomial, PixelRect::frame(p), field, fieldStride, resumeFrom);
+            return;
+        }
+        const int bands = (p.height + band_rows - 1) / band_rows;
+        m_pool.parallel_for(bands, [&](const int band)
+        {
+            const int top = band * band_rows;
+            const PixelRect rows{0, top, p.width, std::min(band_rows, p.height - top)};
+            render_field_cpu(p, *prepared_polynomial, rows, field + static_cast<std::size_t>(top) * fieldStride, fieldStride, resumeFrom);
+        });
+    }
+
+    RenderTask Renderer::render_async(RenderParams p, std::uint8_t* out, const std::size_t stride)
+    {
+        auto progress = std::make_shared<RenderProgress>();
+        auto result = std::async(std::launch::async, [this, p = std::move(p), out, stride, progress]
+        {
+            if (p.width <= 0 || p.height <= 0 || out == nullptr || stride < static_cast<std::size_t>(p.width) * 4u)
+            {
+                throw std::invalid_argument("render_async needs a non-empty image and a stride of at least one row");
+            }
+            if (progress->cancelled.load(std::memory_order_relaxed))
+            {
+                return RenderStatus::CANCELLED;
+            }
+            const auto prepared_polynomial = prepared(p);
+            return render_tiles(p, *prepared_polynomial, PixelRect::frame(p), ImageView{out, p.width, p.height, stride}, progress.get());
+        });
+        return RenderTask{std::move(progress), std::move(result)};
+    }
+
+    RenderTask::RenderTask(std::shared_ptr<RenderProgress> progress, std::future<RenderStatus> result) noexcept :
+        m_progress(std::move(progress)),
+        m_result(std::move(result))
+    {
+    }
+
+    RenderTask& RenderTask::operator=(RenderTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            cancel();
+            // Assigning the future waits for the cancelled render, as the destructor does
+            m_result = std::move(other.m_result);
+            m_progress = std::move(other.m_progress);
+        }
+        return *this;
+    }
+
+    RenderTask::~RenderTask()
+    {
+        // The future of std::async waits for the render in its destructor; make that wait short
+        cancel();
+    }
+
+    void RenderTask::cancel() noexcept
+    {
+        if (m_progress != nullptr)
+        {
+            m_progress->cancelled.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    int RenderTask::tiles_done() const noexcept
+    {
+        return m_progress != nullptr ? m_progress->tilesDone.load(std::memory_order_relaxed) : 0;
+    }
+
+    int RenderTask::tiles_total() const noexcept
+    {
+        return m_progress != nullptr ? m_progress->tilesTotal.load(std::memory_order_relaxed) : 0;
+    }
+
+    float RenderTask::progress() const noexcept
+    {
+        const int total = tiles_total();
+        return total > 0 ? static_cast<float>(tiles_done()) / static_cast<float>(total) : 0.0f;
+    }
+
+    bool RenderTask::ready() const
+    {
+        return m_result.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+    }
+
+    void RenderTask::wait() const
+    {
+        m_result.wait();
+    }
+
+    bool RenderTask::wait_until(const std::chrono::steady_clock::time_point deadline) const
+    {
+        return m_result.wait_until(deadline) == std::future_status::ready;
+    }
+
+    RenderStatus RenderTask::get()
+    {
+        return m_result.get();
+    }
+}
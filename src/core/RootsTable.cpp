@@ -1,10 +1,138 @@
 #include "core/RootsTable.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 #include <numbers>
 
+#include "core/Polynomial.hpp"
+
 namespace nfract
 {
+    namespace
+    {
+        /// p(z) / p'(z) for monic coefficients (highest degree first). Outside the unit disc the reversed polynomial
+        /// is evaluated at 1/z instead, so high degrees never overflow.
+        [[nodiscard]] std::complex<double> newton_ratio(const std::span<const std::complex<double>> c, const std::complex<double> z) noexcept
+        {
+            const int n = static_cast<int>(c.size()) - 1;
+            if (std::norm(z) <= 1.0)
+            {
+                std::complex<double> f = c[0];
+                std::complex<double> df = 0.0;
+                for (int k = 1; k <= n; ++k)
+                {
+                    df = df * z + f;
+                    f = f * z + c[static_cast<std::size_t>(k)];
+                }
+                return f / df;
+            }
+
+            // p(z) = z^n q(w) with w = 1/z and q the reversed polynomial, so p/p' = z q / (n q - w q')
+            const std::complex<double> w = 1.0 / z;
+            std::complex<double> q = c[static_cast<std::size_t>(n)];
+            std::complex<double> dq = 0.0;
+            for (int k = n - 1; k >= 0; --k)
+            {
+                dq = dq * w + q;
+                q = q * w + c[static_cast<std::size_t>(k)];
+            }
+            return z * q / (static_cast<double>(n) * q - w * dq);
+        }
+
+        /// Aberth-Ehrlich iteration on all roots at once, in double precision. Roots are kept as separate real and
+        /// imaginary arrays so the O(n^2) repulsion sum, the dominant cost, runs as plain vectorizable loops.
+        [[nodiscard]] std::vector<std::complex<double>> solve_roots(const std::span<const std::complex<double>> coefficients)
+        {
+            const int n = static_cast<int>(coefficients.size()) - 1;
+            const auto un = static_cast<std::size_t>(n);
+
+            std::vector<std::complex<double>> monic(coefficients.begin(), coefficients.end());
+            const std::complex<double> lead = monic.front();
+            for (auto& c : monic)
+            {
+                c /= lead;
+            }
+
+            // Start on a circle whose radius is the geometric mean of the root moduli (|a_0 / a_n|^(1/n)), or a
+            // fraction of the Cauchy bound when 0 is a root; rotate it so no guess lies on a symmetry axis
+            double cauchy = 0.0;
+            for (std::size_t k = 1; k <= un; ++k)
+            {
+                cauchy = std::max(cauchy, std::abs(monic[k]));
+            }
+            const double constant = std::abs(monic[un]);
+            const double radius = constant > 0.0 ? std::pow(constant, 1.0 / static_cast<double>(n)) : 0.5 * (1.0 + cauchy);
+
+            std::vector<double> re(un);
+            std::vector<double> im(un);
+            for (int k = 0; k < n; ++k)
+            {
+                const double theta = 2.0 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n) + 0.4;
+                re[static_cast<std::size_t>(k)] = radius * std::cos(theta);
+                im[static_cast<std::size_t>(k)] = radius * std::sin(theta);
+            }
+
+            std::vector<double> sum_re(un);
+            std::vector<double> sum_im(un);
+            std::vector<std::uint8_t> done(un, std::uint8_t{0});
+            std::size_t remaining = un;
+            constexpr int max_iterations = 200;
+            for (int it = 0; it < max_iterations && remaining > 0; ++it)
+            {
+                // S_i = sum_{j != i} 1 / (z_i - z_j), accumulated one z_j at a time across all i. The inner loops are
+                // element-wise over the SoA arrays (no reduction), so they vectorize without relaxed FP semantics.
+                std::ranges::fill(sum_re, 0.0);
+                std::ranges::fill(sum_im, 0.0);
+                for (std::size_t j = 0; j < un; ++j)
+                {
+                    const double rj = re[j];
+                    const double ij = im[j];
+                    const auto accumulate = [&](const std::size_t begin, const std::size_t end)
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            const double dr = re[i] - rj;
+                            const double di = im[i] - ij;
+                            const double inv = 1.0 / (dr * dr + di * di);
+                            sum_re[i] += dr * inv;
+                            sum_im[i] -= di * inv;
+                        }
+                    };
+                    accumulate(0, j);
+                    accumulate(j + 1, un);
+                }
+
+                // Aberth correction w_i = N_i / (1 - N_i S_i) with N_i = p(z_i) / p'(z_i)
+                for (std::size_t i = 0; i < un; ++i)
+                {
+                    if (done[i] != 0)
+                    {
+                        continue;
+                    }
+
+                    const std::complex<double> ratio = newton_ratio(monic, {re[i], im[i]});
+                    const std::complex<double> step = ratio / (1.0 - ratio * std::complex{sum_re[i], sum_im[i]});
+                    re[i] -= step.real();
+                    im[i] -= step.imag();
+
+                    if (std::abs(step) <= 1e-14 * std::max(1.0, std::hypot(re[i], im[i])))
+                    {
+                        done[i] = 1;
+                        --remaining;
+                    }
+                }
+            }
+
+            std::vector<std::complex<double>> roots(un);
+            for (std::size_t k = 0; k < un; ++k)
+            {
+                roots[k] = {re[k], im[k]};
+            }
+            return roots;
+        }
+    }
+
     RootsTable::RootsTable(const int n)
     {
         if (n <= 0)
@@ -25,6 +153,39 @@ namespace nfract
         }
     }
 
+    RootsTable::RootsTable(const Polynomial& polynomial)
+    {
+        if (polynomial.degree() <= 0)
+        {
+            throw std::invalid_argument("RootsTable size must be positive");
+        }
+
+        const auto roots = solve_roots(polynomial.coefficients());
+        m_re.reserve(roots.size());
+        m_im.reserve(roots.size());
+        for (const auto& r : roots)
+        {
+            m_re.push_back(static_cast<value_type>(r.real()));
+            m_im.push_back(static_cast<value_type>(r.imag()));
+        }
+    }
+
+    RootsTable::RootsTable(const std::span<const std::complex<double>> roots)
+    {
+        if (roots.empty())
+        {
+            throw std::invalid_argument("RootsTable size must be positive");
+        }
+
+        m_re.reserve(roots.size());
+        m_im.reserve(roots.size());
+        for (const auto& r : roots)
+        {
+            m_re.push_back(static_cast<value_type>(r.real()));
+            m_im.push_back(static_cast<value_type>(r.imag()));
+        }
+    }
+
     int RootsTable::size() const noexcept
     {
         return static_cast<int>(m_re.size());
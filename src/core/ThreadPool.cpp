@@ -0,0 +1,112 @@
+#include "core/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace nfract
+{
+    ThreadPool::ThreadPool(const int threads)
+    {
+        const int workers = threads > 0 ? threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+        m_workers.reserve(static_cast<std::size_t>(workers));
+        for (int i = 0; i < workers; ++i)
+        {
+            m_workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            const std::lock_guard lock{m_mutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    int ThreadPool::concurrency() const noexcept
+    {
+        return static_cast<int>(m_workers.size()) + 1;
+    }
+
+    void ThreadPool::Job::drain() noexcept
+    {
+        for (int index = next.fetch_add(1, std::memory_order_relaxed); index < count; index = next.fetch_add(1, std::memory_order_relaxed))
+        {
+            body(context, index);
+        }
+    }
+
+    void ThreadPool::run(Job& job)
+    {
+        if (job.count <= 0)
+        {
+            return;
+        }
+        if (job.count > 1 && !m_workers.empty())
+        {
+            {
+                const std::lock_guard lock{m_mutex};
+                job.linked = true;
+                (m_tail != nullptr ? m_tail->following : m_head) = &job;
+                m_tail = &job;
+            }
+            m_wake.notify_all();
+        }
+
+        job.drain();
+
+        // Every index is claimed; wait for workers still finishing theirs before the job leaves the caller's stack
+        std::unique_lock lock{m_mutex};
+        unlink(job);
+        m_done.wait(lock, [&job] { return job.active == 0; });
+    }
+
+    void ThreadPool::work()
+    {
+        std::unique_lock lock{m_mutex};
+        while (true)
+        {
+            m_wake.wait(lock, [this] { return m_stop || m_head != nullptr; });
+            if (m_head == nullptr)
+            {
+                return;
+            }
+
+            Job& job = *m_head;
+            ++job.active;
+            lock.unlock();
+            job.drain();
+            lock.lock();
+
+            unlink(job);
+            if (--job.active == 0)
+            {
+                m_done.notify_all();
+            }
+        }
+    }
+
+    void ThreadPool::unlink(Job& job) noexcept
+    {
+        if (!job.linked)
+        {
+            return;
+        }
+        Job* previous = nullptr;
+        for (Job* it = m_head; it != &job; it = it->following)
+        {
+            previous = it;
+        }
+        (previous != nullptr ? previous->following : m_head) = job.following;
+        if (m_tail == &job)
+        {
+            m_tail = previous;
+        }
+        job.following = nullptr;
+        job.linked = false;
+    }
+}
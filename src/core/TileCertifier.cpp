@@ -0,0 +1,220 @@
+#include "core/TileCertifier.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace nfract
+{
+    namespace
+    {
+        /// Unit roundoff of float: a correctly rounded float operation errs by at most this much, relatively
+        constexpr double unit = 0x1p-24;
+
+        /// NewtonStep stops a pixel whose |f'|^2 falls below this
+        constexpr double min_derivative2 = static_cast<double>(1e-12f);
+
+        /// A disc that has grown this many times past the tile is straddling basins; no point stepping it further
+        constexpr double max_growth = 4.0;
+
+        /// Newton converges quadratically, so a disc whose pixels have not all stopped this many steps after the first
+        /// could is stuck at the rounding floor, with a tolerance too tight to certify
+        constexpr int max_spread = 3;
+    }
+
+    TileCertifier::TileCertifier(const std::span<const std::complex<double>> coefficients, const RootsTable& roots, const int maxIter, const float tolerance,
+                                 const StopTest stopTest)
+        : m_coefficients(coefficients.begin(), coefficients.end())
+        , m_roots(roots)
+        , m_maxIter(maxIter)
+        , m_tol2(static_cast<double>(tolerance * tolerance))
+        , m_stopTest(stopTest)
+        , m_taylor(coefficients.size())
+    {
+        m_magnitudes.reserve(m_coefficients.size());
+        for (const auto& a : m_coefficients)
+        {
+            m_magnitudes.push_back(std::abs(a));
+        }
+    }
+
+    void TileCertifier::expand(const std::complex<double> center) noexcept
+    {
+        // Repeated synthetic division by (z - center): each pass leaves the next Taylor coefficient as its remainder
+        const int n = static_cast<int>(m_coefficients.size()) - 1;
+        std::copy(m_coefficients.begin(), m_coefficients.end(), m_taylor.begin());
+        for (int j = 0; j <= n; ++j)
+        {
+            for (int i = 1; i <= n - j; ++i)
+            {
+                m_taylor[static_cast<std::size_t>(i)] += m_taylor[static_cast<std::size_t>(i - 1)] * center;
+            }
+        }
+        // The remainders sit at the tail, f(center) last
+        std::reverse(m_taylor.begin(), m_taylor.end());
+    }
+
+    int TileCertifier::nearest_root(const std::complex<double> center, const double radius) const noexcept
+    {
+        const auto roots_re = m_roots.re();
+        const auto roots_im = m_roots.im();
+
+        // The classifier's float distances err by a few ulps; compare with that much room
+        int found = -1;
+        double found_far2 = 0.0;
+        for (int k = 0; k < m_roots.size(); ++k)
+        {
+            const std::complex<double> root{roots_re[static_cast<std::size_t>(k)], roots_im[static_cast<std::size_t>(k)]};
+            const double far = std::abs(center - root) + radius;
+            const double far2 = far * far * (1.0 + 8.0 * unit);
+            if (far2 < m_tol2)
+            {
+                found = k;
+                found_far2 = far2;
+                break;
+            }
+        }
+        if (found < 0)
+        {
+            return -1;
+        }
+
+        for (int k = 0; k < m_roots.size(); ++k)
+        {
+            if (k == found)
+            {
+                continue;
+            }
+            const std::complex<double> root{roots_re[static_cast<std::size_t>(k)], roots_im[static_cast<std::size_t>(k)]};
+            const double near = std::abs(center - root) - radius;
+            if (near <= 0.0 || near * near * (1.0 - 8.0 * unit) <= found_far2)
+            {
+                return -1;
+            }
+        }
+        return found;
+    }
+
+    TileCertificate TileCertifier::certify(std::complex<double> center, double radius)
+    {
+        const int n = static_cast<int>(m_coefficients.size()) - 1;
+        if (n < 1 || n > max_degree || m_roots.empty() || !(radius >= 0.0) || m_magnitudes.front() == 0.0)
+        {
+            return {};
+        }
+
+        // Both the power loop of z^n - 1 and Horner's scheme err by at most about 2n ulps of sum |a_k| |z|^k in
+        // complex float; twice that covers contracted multiply-adds and the float derivative coefficients
+        const double gamma = 8.0 * static_cast<double>(n + 2) * unit;
+        const double max_radius = max_growth * radius + std::sqrt(m_tol2);
+
+        int root = -1;
+        int first = -1;
+        for (int iter = 0; iter < m_maxIter; ++iter)
+        {
+            expand(center);
+
+            // Bounds on the disc: |f - f(c)|, |f' - f'(c)| and |f''| from the Taylor expansion at c
+            double spread0 = 0.0;
+            double spread1 = 0.0;
+            double bound2 = 0.0;
+            double power = 1.0; // radius^(j - 1)
+            double lower = 0.0; // radius^(j - 2)
+            for (int j = 1; j <= n; ++j)
+            {
+                const double t = std::abs(m_taylor[static_cast<std::size_t>(j)]);
+                spread0 += t * power * radius;
+                if (j >= 2)
+                {
+                    spread1 += static_cast<double>(j) * t * power;
+                    bound2 += static_cast<double>(j * (j - 1)) * t * lower;
+                }
+                lower = power;
+                power *= radius;
+            }
+            const double f0 = std::abs(m_taylor[0]);
+            const double f1 = std::abs(m_taylor[1]);
+            const double fmax = f0 + spread0;
+            const double fmin = f0 - spread0;
+            const double dmin = f1 - spread1;
+
+            // How far the kernel's float f and f' can be from the exact ones anywhere in the disc
+            const double reach = std::abs(center) + radius;
+            double sum0 = 0.0;
+            double sum1 = 0.0;
+            double scale = 1.0; // reach^d for the degree d of m_magnitudes[k]
+            double below = 0.0; // reach^(d - 1)
+            for (int k = n; k >= 0; --k)
+            {
+                const double a = m_magnitudes[static_cast<std::size_t>(k)];
+                sum0 += a * scale;
+                sum1 += static_cast<double>(n - k) * a * below;
+                below = scale;
+                scale *= reach;
+            }
+            const double ef = gamma * sum0;
+            const double ed = gamma * sum1;
+            if (!std::isfinite(fmax) || !std::isfinite(ef) || !std::isfinite(ed))
+            {
+                return {};
+            }
+
+            // The tolerance test on the float |f|^2, which itself errs by a few ulps. The Newton step test
+            // n^2 |f|^2 < tol^2 |f'|^2 is that test against tol |f'| / n, bounded over the disc by |f'|'s bounds.
+            const double high = fmax + ef;
+            const double low = fmin - ef;
+            const double dlow = dmin - ed;
+            double stop_low2 = m_tol2; // below this |f|^2 every pixel stops, at or above it none does
+            double stop_high2 = m_tol2;
+            double slack = 4.0 * unit;
+            if (m_stopTest == StopTest::NEWTON_STEP)
+            {
+                const double dhigh = f1 + spread1 + ed;
+                const double n2 = static_cast<double>(n) * static_cast<double>(n);
+                stop_low2 = dlow > 0.0 ? m_tol2 * dlow * dlow / n2 : 0.0;
+                stop_high2 = m_tol2 * dhigh * dhigh / n2;
+                slack = 8.0 * unit;
+            }
+            const bool all_stop = high * high * (1.0 + slack) < stop_low2;
+            const bool none_stop = low > 0.0 && low * low * (1.0 - slack) >= stop_high2;
+            if (!none_stop)
+            {
+                const int nearest = nearest_root(center, radius);
+                if (nearest < 0 || (root >= 0 && nearest != root))
+                {
+                    return {};
+                }
+                root = nearest;
+                first = first < 0 ? iter : first;
+                if (all_stop)
+                {
+                    return {true, root, first, iter};
+                }
+                if (iter - first >= max_spread)
+                {
+                    return {};
+                }
+            }
+
+            // Pixels still running take a step; none may hit the kernel's vanishing derivative test
+            if (!(dlow > 0.0) || dlow * dlow * (1.0 - 4.0 * unit) < min_derivative2)
+            {
+                return {};
+            }
+            const double step = high / dlow;
+            const double lipschitz = fmax * bound2 / (dmin * dmin);
+            const double rounding = (ef + fmax * ed / dlow) / dlow + 8.0 * unit * step + 2.0 * unit * (reach + step);
+
+            const std::complex<double> next = center - m_taylor[0] / m_taylor[1];
+            radius = lipschitz * radius + rounding + 1e-15 * (reach + step);
+            center = next;
+            if (!std::isfinite(radius) || radius > max_radius)
+            {
+                return {};
+            }
+        }
+
+        // Some pixels may still be running when the budget ends
+        return {};
+    }
+}
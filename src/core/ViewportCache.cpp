@@ -0,0 +1,124 @@
+#include "core/ViewportCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace nfract
+{
+    namespace
+    {
+        /// Everything but the viewport and the palette
+        [[nodiscard]] bool same_iteration(const RenderParams& a, const RenderParams& b)
+        {
+            return a.degree == b.degree && a.maxIter == b.maxIter && a.tolerance == b.tolerance && a.precision == b.precision
+                && a.method == b.method && a.form == b.form && a.coefficients == b.coefficients
+                && a.parameterCoefficients == b.parameterCoefficients && a.roots == b.roots && a.expression == b.expression;
+        }
+
+        [[nodiscard]] bool same_viewport(const RenderParams& a, const RenderParams& b)
+        {
+            return a.width == b.width && a.height == b.height && a.xmin == b.xmin && a.xmax == b.xmax && a.ymin == b.ymin
+                && a.ymax == b.ymax && a.xminDecimal == b.xminDecimal && a.xmaxDecimal == b.xmaxDecimal
+                && a.yminDecimal == b.yminDecimal && a.ymaxDecimal == b.ymaxDecimal;
+        }
+
+        /// Plane distance between neighbouring pixels, as the kernels derive it
+        [[nodiscard]] double pixel_step(const float min, const float max, const int count) noexcept
+        {
+            return (static_cast<double>(max) - static_cast<double>(min)) / static_cast<double>(std::max(1, count - 1));
+        }
+    }
+
+    ViewportCache::ViewportCache(Renderer& renderer) :
+        m_renderer(renderer)
+    {
+    }
+
+    void ViewportCache::map_axis(const double oldStart, const double oldStep, const int oldCount, const double start, const double step, const int count, std::vector<int>& map)
+    {
+        map.assign(static_cast<std::size_t>(count), -1);
+        if (oldStep == 0.0)
+        {
+            return;
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            const double position = (start + step * static_cast<double>(i) - oldStart) / oldStep;
+            const double nearest = std::round(position);
+            if (std::abs(position - nearest) <= max_offset && nearest >= 0.0 && nearest < static_cast<double>(oldCount))
+            {
+                map[static_cast<std::size_t>(i)] = static_cast<int>(nearest);
+            }
+        }
+    }
+
+    ViewportStats ViewportCache::render(const RenderParams& p, std::uint8_t* out, const std::size_t stride)
+    {
+        if (p.width <= 0 || p.height <= 0 || out == nullptr || stride < static_cast<std::size_t>(p.width) * 4u)
+        {
+            return {};
+        }
+
+        const std::size_t width = static_cast<std::size_t>(p.width);
+        m_next.assign(width * static_cast<std::size_t>(p.height), FieldSample{});
+
+        ViewportStats stats;
+        if (m_valid && same_iteration(m_params, p) && (p.precision == Precision::SINGLE || same_viewport(m_params, p)))
+        {
+            map_axis(m_params.xmin, pixel_step(m_params.xmin, m_params.xmax, m_params.width), m_params.width,
+                     p.xmin, pixel_step(p.xmin, p.xmax, p.width), p.width, m_columns);
+            map_axis(m_params.ymin, pixel_step(m_params.ymin, m_params.ymax, m_params.height), m_params.height,
+                     p.ymin, pixel_step(p.ymin, p.ymax, p.height), p.height, m_rows);
+
+            const std::size_t oldWidth = static_cast<std::size_t>(m_params.width);
+            for (int y = 0; y < p.height; ++y)
+            {
+                const int oldY = m_rows[static_cast<std::size_t>(y)];
+                if (oldY < 0)
+                {
+                    continue;
+                }
+                const FieldSample* from = m_field.data() + static_cast<std::size_t>(oldY) * oldWidth;
+                FieldSample* to = m_next.data() + static_cast<std::size_t>(y) * width;
+                for (std::size_t x = 0; x < width; ++x)
+                {
+                    if (m_columns[x] >= 0)
+                    {
+                        to[x] = from[m_columns[x]];
+                        ++stats.reused;
+                    }
+                }
+            }
+        }
+        stats.computed = p.width * p.height - stats.reused;
+
+        if (stats.computed > 0)
+        {
+            m_renderer.render_field(p, m_next.data(), width);
+        }
+
+        m_renderer.shade_field(p, PixelRect::frame(p), m_next.data(), width, ImageView{out, p.width, p.height, stride});
+
+        std::swap(m_field, m_next);
+        m_params = p;
+        m_valid = true;
+        return stats;
+    }
+
+    ViewportStats ViewportCache::render(const RenderParams& p, Image& image)
+    {
+        if (image.width() != p.width || image.height() != p.height)
+        {
+            return {};
+        }
+        return render(p, image.data(), image.stride());
+    }
+
+    void ViewportCache::clear() noexcept
+    {
+        m_valid = false;
+        m_field = {};
+        m_next = {};
+    }
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <stdexcept>
+#include <string>
 
 #include "app/ArgumentsParser.hpp"
 #include "../support/TestUtils.hpp"
@@ -119,6 +121,24 @@ TEST(ArgumentsParserTest, ParsesNeonFlag)
     EXPECT_EQ(args.colorMode, ColorMode::NEON);
 }
 
+TEST(ArgumentsParserTest, ParsesEqualizedFlag)
+{
+    const ArgvBuilder argv{"nfract", "--equalized"};
+    EXPECT_EQ(ArgumentsParser::parse(argv.span()).colorMode, ColorMode::EQUALIZED);
+
+    const ArgvBuilder atlas{"nfract", "--atlas-degrees", "3", "--atlas-palettes", "equalized"};
+    EXPECT_EQ(ArgumentsParser::parse(atlas.span()).atlas[0].colorMode, ColorMode::EQUALIZED);
+}
+
+TEST(ArgumentsParserTest, ParsesFastMathShading)
+{
+    const ArgvBuilder argv{"nfract", "--neon", "--fast-math-shading"};
+    EXPECT_TRUE(ArgumentsParser::parse(argv.span()).fastShading);
+
+    const ArgvBuilder none{"nfract", "--neon"};
+    EXPECT_FALSE(ArgumentsParser::parse(none.span()).fastShading);
+}
+
 TEST(ArgumentsParserTest, RejectsNeonAndJewelryTogether)
 {
     const ArgvBuilder argv{
@@ -144,3 +164,308 @@ TEST(ArgumentsParserTest, ThrowsWhenYminIsNotLessThanYmax)
 
     EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(argv.span())), std::invalid_argument);
 }
+
+TEST(ArgumentsParserTest, KeepsDecimalBoundsAndParsesPrecision)
+{
+    const ArgvBuilder argv{
+        "nfract",
+        "--precision", "double-double",
+        "--xmin", "-0.74364388703715870475",
+        "--xmax", "-0.74364388703715870474",
+        "--ymin", "0.13182590420531197049",
+        "--ymax", "0.13182590420531197050"
+    };
+
+    const Arguments args = ArgumentsParser::parse(argv.span());
+
+    EXPECT_EQ(args.precision, nfract::Precision::DOUBLE_DOUBLE);
+    EXPECT_EQ(args.xminDecimal, "-0.74364388703715870475");
+    EXPECT_EQ(args.ymaxDecimal, "0.13182590420531197050");
+    EXPECT_FLOAT_EQ(args.xmin, -0.74364388703715870475f);
+}
+
+TEST(ArgumentsParserTest, ComparesBoundsBeyondFloatPrecision)
+{
+    const ArgvBuilder argv{
+        "nfract",
+        "--xmin", "0.10000000000000000000002",
+        "--xmax", "0.10000000000000000000001"
+    };
+
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(argv.span())), std::invalid_argument);
+}
+
+TEST(ArgumentsParserTest, RejectsBoundsThatMeetInSinglePrecision)
+{
+    const ArgvBuilder single{"nfract", "--xmin", "1.00000001", "--xmax", "1.00000002"};
+    const ArgvBuilder narrow_y{"nfract", "--ymin", "1.00000001", "--ymax", "1.00000002"};
+    const ArgvBuilder deep{"nfract", "--precision", "double-double", "--xmin", "1.00000001", "--xmax", "1.00000002"};
+
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(single.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(narrow_y.span())), std::invalid_argument);
+    EXPECT_EQ(ArgumentsParser::parse(deep.span()).xmaxDecimal, "1.00000002");
+}
+
+TEST(ArgumentsParserTest, RejectsBoundsThatOverflow)
+{
+    const ArgvBuilder single{"nfract", "--xmax", "1e100000"};
+    const ArgvBuilder beyond_float{"nfract", "--ymin", "-1e39"};
+    const ArgvBuilder perturbation{"nfract", "--precision", "perturbation", "--xmax", "1e100000"};
+    const ArgvBuilder double_double{"nfract", "--precision", "double-double", "--ymin", "-1e39"};
+
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(single.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(beyond_float.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(perturbation.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(double_double.span())), std::invalid_argument);
+}
+
+TEST(ArgumentsParserTest, AcceptsPerturbationBoundsBeyondDoubleDouble)
+{
+    const ArgvBuilder argv{
+        "nfract",
+        "--precision", "perturbation",
+        "--xmin", "0.100000000000000000000000000000000000000000000001",
+        "--xmax", "0.100000000000000000000000000000000000000000000002"
+    };
+
+    const Arguments args = ArgumentsParser::parse(argv.span());
+    EXPECT_EQ(args.precision, nfract::Precision::PERTURBATION);
+    EXPECT_EQ(args.xmaxDecimal, "0.100000000000000000000000000000000000000000000002");
+}
+
+TEST(ArgumentsParserTest, RejectsPerturbationViewsBelowDoubleRange)
+{
+    // Spans of 1e-300 and 1e-320 over the default 1920 x 1080 pixels
+    const std::string zeros(299, '0');
+    const std::string xmin = "0.1" + zeros + "1";
+    const std::string shallow = "0.1" + zeros + "2";
+    const std::string deep_min = "0.1" + zeros + std::string(20, '0') + "1";
+    const std::string deep_max = "0.1" + zeros + std::string(20, '0') + "2";
+
+    const ArgvBuilder fits{"nfract", "--precision", "perturbation", "--xmin", xmin, "--xmax", shallow,
+                           "--ymin", xmin, "--ymax", shallow};
+    const ArgvBuilder underflows{"nfract", "--precision", "perturbation", "--xmin", deep_min, "--xmax", deep_max,
+                                 "--ymin", xmin, "--ymax", shallow};
+
+    EXPECT_EQ(ArgumentsParser::parse(fits.span()).xmaxDecimal, shallow);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(underflows.span())), std::invalid_argument);
+}
+
+TEST(ArgumentsParserTest, ParsesComplexCoefficients)
+{
+    const ArgvBuilder argv{
+        "nfract",
+        "--coeffs", "1,0,-2+1i,0.5i,-i,1e-1-2.5e+1i"
+    };
+
+    const Arguments args = ArgumentsParser::parse(argv.span());
+
+    EXPECT_EQ(args.form, nfract::PolynomialForm::COEFFICIENTS);
+    ASSERT_EQ(args.coefficients.size(), 6u);
+    EXPECT_EQ(args.coefficients[0], std::complex<double>(1.0, 0.0));
+    EXPECT_EQ(args.coefficients[2], std::complex<double>(-2.0, 1.0));
+    EXPECT_EQ(args.coefficients[3], std::complex<double>(0.0, 0.5));
+    EXPECT_EQ(args.coefficients[4], std::complex<double>(0.0, -1.0));
+    EXPECT_EQ(args.coefficients[5], std::complex<double>(0.1, -25.0));
+}
+
+TEST(ArgumentsParserTest, RejectsMalformedOrConstantCoefficients)
+{
+    const ArgvBuilder malformed{"nfract", "--coeffs", "1,abc"};
+    const ArgvBuilder constant{"nfract", "--coeffs", "0,0,3"};
+    const ArgvBuilder deep{"nfract", "--coeffs", "1,0,-1", "--precision", "double-double"};
+    const ArgvBuilder not_a_number{"nfract", "--coeffs", "1,nan,-1"};
+    const ArgvBuilder infinite{"nfract", "--coeffs", "1,0,-1+infi"};
+
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(malformed.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(constant.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(not_a_number.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(infinite.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(deep.span())), std::invalid_argument);
+}
+
+TEST(ArgumentsParserTest, ReadsRootsFile)
+{
+    const nfract::test::TempFileGuard file{nfract::test::make_unique_path("nfract-roots", ".txt")};
+    {
+        std::ofstream out{file.path()};
+        out << "# roots of the test polynomial\n"
+            << "1 -1\n"
+            << "0.5+2i, -i  # trailing comment\n";
+    }
+
+    const ArgvBuilder argv{"nfract", "--roots-file", file.path().string()};
+    const Arguments args = ArgumentsParser::parse(argv.span());
+
+    EXPECT_EQ(args.form, nfract::PolynomialForm::ROOTS);
+    ASSERT_EQ(args.roots.size(), 4u);
+    EXPECT_EQ(args.roots[0], std::complex<double>(1.0, 0.0));
+    EXPECT_EQ(args.roots[1], std::complex<double>(-1.0, 0.0));
+    EXPECT_EQ(args.roots[2], std::complex<double>(0.5, 2.0));
+    EXPECT_EQ(args.roots[3], std::complex<double>(0.0, -1.0));
+}
+
+TEST(ArgumentsParserTest, RejectsEmptyOrMalformedRootsFile)
+{
+    const nfract::test::TempFileGuard empty{nfract::test::make_unique_path("nfract-roots", ".txt")};
+    const nfract::test::TempFileGuard malformed{nfract::test::make_unique_path("nfract-roots", ".txt")};
+    std::ofstream{empty.path()} << "# nothing here\n";
+    std::ofstream{malformed.path()} << "1 2x\n";
+
+    const ArgvBuilder no_roots{"nfract", "--roots-file", empty.path().string()};
+    const ArgvBuilder bad_root{"nfract", "--roots-file", malformed.path().string()};
+
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(no_roots.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(bad_root.span())), std::invalid_argument);
+}
+
+TEST(ArgumentsParserTest, ParsesMethod)
+{
+    const ArgvBuilder halley{"nfract", "--method", "halley"};
+    const ArgvBuilder householder{"nfract", "--method", "Householder3"};
+    const ArgvBuilder deep{"nfract", "--method", "schroder", "--precision", "double-double"};
+    const ArgvBuilder unknown{"nfract", "--method", "secant"};
+
+    EXPECT_EQ(ArgumentsParser::parse(ArgvBuilder{"nfract"}.span()).method, nfract::Method::NEWTON);
+    EXPECT_EQ(ArgumentsParser::parse(halley.span()).method, nfract::Method::HALLEY);
+    EXPECT_EQ(ArgumentsParser::parse(householder.span()).method, nfract::Method::HOUSEHOLDER3);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(deep.span())), std::invalid_argument);
+    EXPECT_EXIT(static_cast<void>(ArgumentsParser::parse(unknown.span())), ::testing::ExitedWithCode(105), ".*");
+}
+
+TEST(ArgumentsParserTest, ParsesExpression)
+{
+    const ArgvBuilder argv{"nfract", "--expr", "z^3 - 2z + 1i"};
+    const Arguments args = ArgumentsParser::parse(argv.span());
+
+    EXPECT_EQ(args.form, nfract::PolynomialForm::EXPRESSION);
+    EXPECT_EQ(args.expression, "z^3 - 2z + 1i");
+    ASSERT_EQ(args.coefficients.size(), 4u);
+    EXPECT_EQ(args.coefficients[2], std::complex<double>(-2.0, 0.0));
+    EXPECT_EQ(args.coefficients[3], std::complex<double>(0.0, 1.0));
+
+    const ArgvBuilder malformed{"nfract", "--expr", "z^3 +"};
+    const ArgvBuilder deep{"nfract", "--expr", "z^3 - 1", "--precision", "double-double"};
+    const ArgvBuilder both{"nfract", "--expr", "z^3 - 1", "--coeffs", "1,0,0,-1"};
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(malformed.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(deep.span())), std::invalid_argument);
+    EXPECT_EXIT(static_cast<void>(ArgumentsParser::parse(both.span())), ::testing::ExitedWithCode(108), ".*");
+}
+
+TEST(ArgumentsParserTest, ParsesFamily)
+{
+    const ArgvBuilder argv{"nfract", "--family", "z^3 + (a-1)z - a"};
+    const Arguments args = ArgumentsParser::parse(argv.span());
+
+    EXPECT_EQ(args.form, nfract::PolynomialForm::FAMILY);
+    ASSERT_EQ(args.coefficients.size(), 4u);
+    ASSERT_EQ(args.parameterCoefficients.size(), 4u);
+    EXPECT_EQ(args.parameterCoefficients[2], std::complex<double>(1.0, 0.0));
+    EXPECT_EQ(args.parameterCoefficients[3], std::complex<double>(-1.0, 0.0));
+
+    const ArgvBuilder no_parameter{"nfract", "--family", "z^3 - 1"};
+    const ArgvBuilder quadratic{"nfract", "--family", "z^2 - a"};
+    const ArgvBuilder halley{"nfract", "--family", "z^3 + (a-1)z - a", "--method", "halley"};
+    const ArgvBuilder in_expr{"nfract", "--expr", "z^3 - a"};
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(no_parameter.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(quadratic.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(halley.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(in_expr.span())), std::invalid_argument);
+}
+
+TEST(ArgumentsParserTest, ParsesAtlas)
+{
+    const ArgvBuilder argv{
+        "nfract", "--atlas-degrees", "2-4,7", "--atlas-palettes", "classic,neon",
+        "--atlas-viewport=-2,2,-2,2", "--atlas-viewport=-0.5,0.5,-0.25,0.25"
+    };
+    const Arguments args = ArgumentsParser::parse(argv.span());
+
+    ASSERT_EQ(args.atlas.size(), 4u * 2u * 2u);
+    EXPECT_EQ(args.atlasColumns, 4);
+    EXPECT_EQ(args.atlas[0].degree, 2);
+    EXPECT_EQ(args.atlas[0].colorMode, nfract::ColorMode::CLASSIC);
+    EXPECT_EQ(args.atlas[1].colorMode, nfract::ColorMode::NEON);
+    EXPECT_FLOAT_EQ(args.atlas[2].xmin, -0.5f);
+    EXPECT_FLOAT_EQ(args.atlas[2].ymax, 0.25f);
+    EXPECT_EQ(args.atlas.back().degree, 7);
+
+    const ArgvBuilder defaults{"nfract", "--atlas-degrees", "5", "--neon", "--xmin", "-1", "--atlas-columns", "3"};
+    const Arguments single = ArgumentsParser::parse(defaults.span());
+    ASSERT_EQ(single.atlas.size(), 1u);
+    EXPECT_EQ(single.atlasColumns, 3);
+    EXPECT_EQ(single.atlas[0].colorMode, nfract::ColorMode::NEON);
+    EXPECT_FLOAT_EQ(single.atlas[0].xmin, -1.0f);
+
+    for (const char* degrees : {"1-3", "4-2", "x", "5,", "2-65"})
+    {
+        const ArgvBuilder bad{"nfract", "--atlas-degrees", degrees};
+        EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(bad.span())), std::invalid_argument) << degrees;
+    }
+    const ArgvBuilder bad_viewport{"nfract", "--atlas-degrees", "3", "--atlas-viewport=1,0,0,1"};
+    const ArgvBuilder deep{"nfract", "--atlas-degrees", "3", "--precision", "double-double"};
+    const ArgvBuilder infinite_viewport{"nfract", "--atlas-degrees", "3", "--atlas-viewport=-1,1e39,0,1"};
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(bad_viewport.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(infinite_viewport.span())), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(deep.span())), std::invalid_argument);
+}
+
+TEST(ArgumentsParserTest, RejectsCertifyTilesWhereItCannotApply)
+{
+    const ArgvBuilder unity{"nfract", "--certify-tiles"};
+    EXPECT_TRUE(ArgumentsParser::parse(unity.span()).certifyTiles);
+    const ArgvBuilder coefficients{"nfract", "--certify-tiles", "--coeffs", "1", "0", "-1"};
+    EXPECT_TRUE(ArgumentsParser::parse(coefficients.span()).certifyTiles);
+
+    const ArgvBuilder neon{"nfract", "--certify-tiles", "--neon"};
+    const ArgvBuilder halley{"nfract", "--certify-tiles", "--method", "halley"};
+    const ArgvBuilder double_double{"nfract", "--certify-tiles", "--precision", "double-double"};
+    const ArgvBuilder expression{"nfract", "--certify-tiles", "--expr", "z^3 - 1"};
+    const ArgvBuilder family{"nfract", "--certify-tiles", "--family", "z^3 + (a - 1) z - a"};
+    const ArgvBuilder atlas{"nfract", "--certify-tiles", "--atlas-degrees", "3-4", "--atlas-palettes", "classic,neon"};
+    for (const ArgvBuilder* argv : {&neon, &halley, &double_double, &expression, &family, &atlas})
+    {
+        EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(argv->span())), std::invalid_argument);
+    }
+
+    // Resumable renders keep per-pixel samples, which certified tiles do not have
+    const ArgvBuilder resumable{"nfract", "--certify-tiles", "--state-out", "deep.state"};
+    EXPECT_EXIT(
+        static_cast<void>(ArgumentsParser::parse(resumable.span())),
+        ::testing::ExitedWithCode(108),
+        ".*"
+    );
+}
+
+TEST(ArgumentsParserTest, ParsesDeadline)
+{
+    const ArgvBuilder argv{"nfract", "--deadline-ms", "250"};
+    EXPECT_EQ(ArgumentsParser::parse(argv.span()).deadlineMs, 250);
+
+    const ArgvBuilder none{"nfract"};
+    EXPECT_EQ(ArgumentsParser::parse(none.span()).deadlineMs, 0);
+}
+
+TEST(ArgumentsParserTest, ParsesStatePaths)
+{
+    const ArgvBuilder argv{"nfract", "--max-iter", "500", "--resume", "shallow.state", "--state-out", "deep.state"};
+    const auto args = ArgumentsParser::parse(argv.span());
+    EXPECT_EQ(args.resumePath, "shallow.state");
+    EXPECT_EQ(args.stateOutPath, "deep.state");
+}
+
+TEST(ArgumentsParserTest, ParsesAutomaticMaxIter)
+{
+    const ArgvBuilder automatic{"nfract", "--max-iter", "auto", "--auto-coverage", "0.95"};
+    const auto args = ArgumentsParser::parse(automatic.span());
+    EXPECT_TRUE(args.maxIterAuto);
+    EXPECT_DOUBLE_EQ(args.maxIterCoverage, 0.95);
+
+    const ArgvBuilder fixed{"nfract", "--max-iter", "250"};
+    const auto fixed_args = ArgumentsParser::parse(fixed.span());
+    EXPECT_FALSE(fixed_args.maxIterAuto);
+    EXPECT_EQ(fixed_args.maxIter, 250);
+
+    const ArgvBuilder coverage_alone{"nfract", "--max-iter", "250", "--auto-coverage", "0.95"};
+    EXPECT_THROW(static_cast<void>(ArgumentsParser::parse(coverage_alone.span())), std::invalid_argument);
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "capi/nfract.h"
+#include "core/Image.hpp"
+#include "core/Renderer.hpp"
+#include "../support/TestUtils.hpp"
+
+namespace
+{
+    [[nodiscard]] nfract_params make_params()
+    {
+        nfract_params params;
+        nfract_params_init(&params);
+        params.width = 21;
+        params.height = 13;
+        params.max_iter = 30;
+        params.xmin = -1.5f;
+        params.xmax = 1.5f;
+        params.ymin = -1.0f;
+        params.ymax = 1.0f;
+        params.tolerance = 1e-4f;
+        return params;
+    }
+
+    [[nodiscard]] nfract::RenderParams to_cpp(const nfract_params& params)
+    {
+        nfract::RenderParams p;
+        p.degree = params.degree;
+        p.width = params.width;
+        p.height = params.height;
+        p.maxIter = params.max_iter;
+        p.xmin = params.xmin;
+        p.xmax = params.xmax;
+        p.ymin = params.ymin;
+        p.ymax = params.ymax;
+        p.tolerance = params.tolerance;
+        p.colorMode = static_cast<nfract::ColorMode>(params.color_mode);
+        p.method = static_cast<nfract::Method>(params.method);
+        return p;
+    }
+
+    /// Renders through the C interface with `padding` spare bytes per row and compares with the C++ Renderer
+    void expect_matches_renderer(const nfract_params& params, const nfract::RenderParams& expected_params)
+    {
+        const std::size_t row_bytes = static_cast<std::size_t>(params.width) * 4u;
+        const std::size_t stride = row_bytes + 8u;
+        std::vector<std::uint8_t> buffer(stride * static_cast<std::size_t>(params.height), 0xAB);
+        ASSERT_EQ(nfract_render(&params, buffer.data(), stride), NFRACT_OK);
+
+        nfract::Renderer renderer{1};
+        nfract::Image expected{params.width, params.height};
+        renderer.render(expected_params, expected);
+        for (int y = 0; y < params.height; ++y)
+        {
+            EXPECT_EQ(std::memcmp(buffer.data() + static_cast<std::size_t>(y) * stride, expected.row(y).data(), row_bytes), 0) << "row " << y;
+            EXPECT_EQ(buffer[static_cast<std::size_t>(y) * stride + row_bytes], 0xAB) << "row " << y;
+        }
+    }
+}
+
+TEST(CApiTest, DefaultsMatchTheCommandLine)
+{
+    nfract_params params;
+    nfract_params_init(&params);
+    const nfract::RenderParams defaults;
+    EXPECT_EQ(params.degree, defaults.degree);
+    EXPECT_EQ(params.width, defaults.width);
+    EXPECT_EQ(params.max_iter, defaults.maxIter);
+    EXPECT_FLOAT_EQ(params.tolerance, defaults.tolerance);
+    EXPECT_EQ(params.color_mode, NFRACT_COLOR_CLASSIC);
+    EXPECT_EQ(params.method, NFRACT_METHOD_NEWTON);
+    EXPECT_EQ(params.coefficients, nullptr);
+    EXPECT_EQ(params.expression, nullptr);
+    EXPECT_EQ(std::string{nfract_version()}, PROJECT_VERSION);
+}
+
+TEST(CApiTest, RendersEachPolynomialFormIntoCallerMemory)
+{
+    const nfract_params unity = make_params();
+    expect_matches_renderer(unity, to_cpp(unity));
+
+    const double coefficients[] = {1.0, 0.0, 0.0, 0.0, -2.0, 1.0, 0.0, 0.5, 1.0, 0.0};
+    nfract_params poly = make_params();
+    poly.coefficients = coefficients;
+    poly.num_coefficients = 5;
+    poly.color_mode = NFRACT_COLOR_JEWELRY;
+    expect_matches_renderer(poly, nfract::test::as_coefficients(to_cpp(poly)));
+
+    const double roots[] = {1.0, 0.0, -0.5, 0.8, -0.5, -0.8};
+    nfract_params listed = make_params();
+    listed.roots = roots;
+    listed.num_roots = 3;
+    listed.method = NFRACT_METHOD_HALLEY;
+    nfract::RenderParams listed_cpp = to_cpp(listed);
+    listed_cpp.form = nfract::PolynomialForm::ROOTS;
+    listed_cpp.roots = {{1.0, 0.0}, {-0.5, 0.8}, {-0.5, -0.8}};
+    expect_matches_renderer(listed, listed_cpp);
+
+    nfract_params expr = make_params();
+    expr.expression = "z^3 - 2z + 2";
+    nfract::RenderParams expr_cpp = to_cpp(expr);
+    expr_cpp.form = nfract::PolynomialForm::EXPRESSION;
+    expr_cpp.expression = "z^3 - 2z + 2";
+    expr_cpp.coefficients = {{1.0, 0.0}, {0.0, 0.0}, {-2.0, 0.0}, {2.0, 0.0}};
+    expect_matches_renderer(expr, expr_cpp);
+}
+
+TEST(CApiTest, OwnRendererAndErrors)
+{
+    nfract_renderer* renderer = nfract_renderer_create(2);
+    ASSERT_NE(renderer, nullptr);
+
+    nfract_params params = make_params();
+    std::vector<std::uint8_t> buffer(static_cast<std::size_t>(params.width * params.height) * 4u);
+    const std::size_t stride = static_cast<std::size_t>(params.width) * 4u;
+    EXPECT_EQ(nfract_renderer_render(renderer, &params, buffer.data(), stride), NFRACT_OK);
+    EXPECT_TRUE(std::ranges::any_of(buffer, [](const auto v) { return v != 0; }));
+
+    EXPECT_EQ(nfract_renderer_render(nullptr, &params, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(nfract_render(nullptr, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(nfract_render(&params, nullptr, stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(nfract_render(&params, buffer.data(), stride - 1), NFRACT_ERROR_INVALID_ARGUMENT);
+
+    nfract_params bad = params;
+    bad.expression = "z^";
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    bad = params;
+    bad.xmax = bad.xmin;
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    bad = params;
+    bad.degree = 1;
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    bad = params;
+    bad.method = 7;
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+
+    // The ranges of the command line
+    for (const float tolerance : {std::numeric_limits<float>::quiet_NaN(), 1e9f, 1e-7f, 0.0f})
+    {
+        bad = params;
+        bad.tolerance = tolerance;
+        EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT) << tolerance;
+    }
+    for (const int max_iter : {0, 10'001, 2'000'000'000})
+    {
+        bad = params;
+        bad.max_iter = max_iter;
+        EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT) << max_iter;
+    }
+    bad = params;
+    bad.xmax = std::numeric_limits<float>::infinity();
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    bad = params;
+    bad.ymin = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+
+    const double roots[] = {1.0, 0.0, std::numeric_limits<double>::quiet_NaN(), 0.8};
+    bad = params;
+    bad.roots = roots;
+    bad.num_roots = 2;
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    const double coefficients[] = {1.0, 0.0, 0.0, 0.0, std::numeric_limits<double>::infinity(), 0.0};
+    bad = params;
+    bad.coefficients = coefficients;
+    bad.num_coefficients = 3;
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    bad.num_coefficients = -3;
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+    bad = params;
+    bad.roots = roots;
+    bad.num_roots = -1;
+    EXPECT_EQ(nfract_render(&bad, buffer.data(), stride), NFRACT_ERROR_INVALID_ARGUMENT);
+
+    nfract_renderer_destroy(renderer);
+    nfract_renderer_destroy(nullptr);
+}
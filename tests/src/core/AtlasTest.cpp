@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "app/ArgumentsParser.hpp"
+#include "core/Atlas.hpp"
+#include "core/RenderNewton.hpp"
+#include "core/RootsTable.hpp"
+
+using nfract::Arguments;
+using nfract::AtlasCell;
+using nfract::ColorMode;
+using nfract::Image;
+
+namespace
+{
+    [[nodiscard]] Arguments make_atlas_args()
+    {
+        Arguments args;
+        args.width = 12;
+        args.height = 9;
+        args.maxIter = 20;
+        args.tolerance = 1e-4f;
+        args.outputPath.clear();
+        args.atlas = {
+            {2, -1.5f, 1.5f, -1.0f, 1.0f, ColorMode::CLASSIC},
+            {5, -1.5f, 1.5f, -1.0f, 1.0f, ColorMode::NEON},
+            {5, -0.5f, 0.5f, -0.5f, 0.5f, ColorMode::JEWELRY},
+            {17, -1.0f, 1.0f, -1.0f, 1.0f, ColorMode::CLASSIC},
+            {3, -2.0f, 2.0f, -2.0f, 2.0f, ColorMode::NEON},
+        };
+        args.atlasColumns = 2;
+        return args;
+    }
+}
+
+TEST(AtlasTest, CellsMatchIndividualRenders)
+{
+    const Arguments args = make_atlas_args();
+    ASSERT_EQ(nfract::atlas_rows(static_cast<int>(args.atlas.size()), args.atlasColumns), 3);
+
+    nfract::Renderer renderer{3};
+    Image atlas{args.width * args.atlasColumns, args.height * 3};
+    nfract::render_atlas(renderer, args, args.atlas, args.atlasColumns, atlas);
+
+    for (std::size_t index = 0; index < args.atlas.size(); ++index)
+    {
+        const AtlasCell& cell = args.atlas[index];
+        Arguments single = make_atlas_args();
+        single.atlas.clear();
+        single.degree = cell.degree;
+        single.xmin = cell.xmin;
+        single.xmax = cell.xmax;
+        single.ymin = cell.ymin;
+        single.ymax = cell.ymax;
+        single.colorMode = cell.colorMode;
+        const nfract::RootsTable roots{cell.degree};
+        Image expected{args.width, args.height};
+#ifdef RUN_ON_CPU
+        nfract::render_newton_cpu(single, roots, expected);
+#else
+        nfract::render_newton_ispc(single, roots, expected);
+#endif
+
+        const int x0 = static_cast<int>(index) % args.atlasColumns * args.width;
+        const int y0 = static_cast<int>(index) / args.atlasColumns * args.height;
+        for (int y = 0; y < args.height; ++y)
+        {
+            EXPECT_EQ(std::memcmp(atlas.pixel(x0, y0 + y), expected.row(y).data(), expected.row(y).size()), 0) << "cell " << index << " row " << y;
+        }
+    }
+
+    // The slot after the last cell is left alone
+    EXPECT_TRUE(std::all_of(atlas.pixel(args.width, 2 * args.height), atlas.pixel(args.width, 2 * args.height) + args.width * 4, [](const auto v) { return v == 0; }));
+}
+
+TEST(AtlasTest, IgnoresMismatchedImage)
+{
+    const Arguments args = make_atlas_args();
+    nfract::Renderer renderer{1};
+    Image wrong{args.width, args.height};
+    nfract::render_atlas(renderer, args, args.atlas, args.atlasColumns, wrong);
+    EXPECT_TRUE(std::ranges::all_of(wrong.pixels(), [](const auto v) { return v == 0; }));
+}
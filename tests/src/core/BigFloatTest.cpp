@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "core/BigFloat.hpp"
+
+using nfract::BigFloat;
+
+TEST(BigFloatTest, DefaultAndZeroValues)
+{
+    const BigFloat zero{4};
+
+    EXPECT_TRUE(zero.is_zero());
+    EXPECT_EQ(zero.to_double(), 0.0);
+    EXPECT_EQ(zero.limbs(), 4);
+    EXPECT_TRUE(BigFloat::parse("-0.000", 4).is_zero());
+}
+
+TEST(BigFloatTest, RoundTripsDoubles)
+{
+    for (const double value : {1.0, -2.5, 0.1, 1e-300, -3.0e250, 123456789.125})
+    {
+        EXPECT_EQ(BigFloat(value, 4).to_double(), value);
+    }
+}
+
+TEST(BigFloatTest, ArithmeticMatchesDoubleOnSimpleValues)
+{
+    const BigFloat a{3.5, 4};
+    const BigFloat b{-1.25, 4};
+
+    EXPECT_EQ((a + b).to_double(), 2.25);
+    EXPECT_EQ((a - b).to_double(), 4.75);
+    EXPECT_EQ((b - a).to_double(), -4.75);
+    EXPECT_EQ((a * b).to_double(), -4.375);
+    EXPECT_EQ((a / b).to_double(), -2.8);
+    EXPECT_TRUE((a - a).is_zero());
+}
+
+TEST(BigFloatTest, KeepsDigitsFarBeyondDoublePrecision)
+{
+    const BigFloat a = BigFloat::parse("1.00000000000000000000000000000000000000000000000001", 8);
+    const BigFloat one{1.0, 8};
+
+    EXPECT_NEAR((a - one).to_double(), 1e-50, 1e-64);
+    EXPECT_TRUE(one < a);
+    EXPECT_FALSE(a < one);
+}
+
+TEST(BigFloatTest, ReciprocalIsAccurateToFullPrecision)
+{
+    const BigFloat three{3.0, 8};
+    const BigFloat third = three.reciprocal();
+    const BigFloat error = third * three - BigFloat{1.0, 8};
+
+    EXPECT_LT(std::abs(error.to_double()), 1e-70);
+    EXPECT_THROW(static_cast<void>(BigFloat{4}.reciprocal()), std::domain_error);
+}
+
+TEST(BigFloatTest, OrderingHandlesSigns)
+{
+    const BigFloat neg = BigFloat::parse("-2", 4);
+    const BigFloat pos = BigFloat::parse("1e-40", 4);
+
+    EXPECT_TRUE(neg < pos);
+    EXPECT_TRUE(BigFloat::parse("-3", 4) < neg);
+    EXPECT_FALSE(pos < pos);
+}
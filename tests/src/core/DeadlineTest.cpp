@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "core/Deadline.hpp"
+#include "core/Image.hpp"
+#include "core/Renderer.hpp"
+#include "../support/TestUtils.hpp"
+
+using nfract::DeadlineRenderer;
+using nfract::DeadlineReport;
+using nfract::Image;
+using nfract::RenderParams;
+using nfract::test::make_params;
+
+TEST(DeadlineTest, GenerousDeadlineRendersAtFullQuality)
+{
+    nfract::Renderer renderer{2};
+    const RenderParams p = make_params(5, 90, 60, 40);
+
+    Image img{p.width, p.height};
+    const DeadlineReport report = DeadlineRenderer::render(renderer, p, std::chrono::minutes{1}, img);
+
+    EXPECT_FALSE(report.degraded);
+    EXPECT_FALSE(report.fellBack);
+    EXPECT_EQ(report.width, p.width);
+    EXPECT_EQ(report.height, p.height);
+    EXPECT_EQ(report.maxIter, p.maxIter);
+    EXPECT_GT(report.estimatedMs, 0.0);
+    EXPECT_GE(report.elapsedMs, report.previewMs);
+
+    Image expected{p.width, p.height};
+    renderer.render(p, expected);
+    EXPECT_TRUE(std::ranges::equal(img.pixels(), expected.pixels()));
+}
+
+TEST(DeadlineTest, TightDeadlineDegradesButFillsTheImage)
+{
+    nfract::Renderer renderer{2};
+    const RenderParams p = make_params(5, 1600, 1200, 1000);
+
+    Image img{p.width, p.height};
+    const DeadlineReport report = DeadlineRenderer::render(renderer, p, std::chrono::milliseconds{1}, img);
+
+    EXPECT_TRUE(report.degraded);
+    EXPECT_TRUE(report.width < p.width || report.maxIter < p.maxIter);
+    EXPECT_LE(report.width, p.width);
+    EXPECT_LE(report.maxIter, p.maxIter);
+
+    // Every pixel came from a render, alpha included
+    for (std::size_t i = 3; i < img.pixels().size(); i += 4)
+    {
+        ASSERT_EQ(img.pixels()[i], 255) << "pixel " << i / 4;
+    }
+}
+
+TEST(DeadlineTest, IgnoresMismatchedImage)
+{
+    nfract::Renderer renderer{1};
+    const RenderParams p = make_params(5, 20, 10, 20);
+    Image wrong{10, 10};
+    const DeadlineReport report = DeadlineRenderer::render(renderer, p, std::chrono::seconds{1}, wrong);
+    EXPECT_EQ(report.width, 0);
+    EXPECT_TRUE(std::ranges::all_of(wrong.pixels(), [](const auto v) { return v == 0; }));
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "core/DoubleDouble.hpp"
+
+using nfract::DoubleDouble;
+
+TEST(DoubleDoubleTest, ParseKeepsDigitsBeyondDoublePrecision)
+{
+    const DoubleDouble tenth = DoubleDouble::parse("0.1");
+
+    EXPECT_EQ(tenth.hi, 0.1);
+    // 0.1 - double(0.1) = -5.5511151231257827e-18
+    EXPECT_NEAR(tenth.lo, -5.5511151231257827e-18, 1e-33);
+}
+
+TEST(DoubleDoubleTest, ParseHandlesSignsAndExponents)
+{
+    EXPECT_EQ(DoubleDouble::parse("-2").hi, -2.0);
+    EXPECT_EQ(DoubleDouble::parse("+1.5e3").hi, 1500.0);
+    EXPECT_EQ(DoubleDouble::parse("25e-1").hi, 2.5);
+    EXPECT_EQ(DoubleDouble::parse(".5").hi, 0.5);
+    EXPECT_EQ(DoubleDouble::parse("1e-400").hi, 0.0);
+}
+
+TEST(DoubleDoubleTest, ParseRejectsMalformedInput)
+{
+    EXPECT_THROW(static_cast<void>(DoubleDouble::parse("")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(DoubleDouble::parse("abc")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(DoubleDouble::parse("1.2.3")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(DoubleDouble::parse("1e")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(DoubleDouble::parse("1e400")), std::invalid_argument);
+}
+
+TEST(DoubleDoubleTest, ArithmeticResolvesDifferencesBelowDoubleEpsilon)
+{
+    const DoubleDouble a = DoubleDouble::parse("1.00000000000000000000000001");
+    const DoubleDouble b{1.0};
+
+    const DoubleDouble diff = a - b;
+    EXPECT_NEAR(diff.hi, 1e-26, 1e-40);
+
+    const DoubleDouble third = DoubleDouble{1.0} / DoubleDouble{3.0};
+    const DoubleDouble back = third * DoubleDouble{3.0};
+    EXPECT_EQ(back.hi, 1.0);
+    EXPECT_LT(std::abs(back.lo), 1e-31);
+}
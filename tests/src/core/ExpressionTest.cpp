@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/Expression.hpp"
+#include "core/IterationKernel.hpp"
+#include "core/Polynomial.hpp"
+
+using nfract::Complex;
+using nfract::Expression;
+using nfract::Jet;
+
+namespace
+{
+    [[nodiscard]] std::vector<std::complex<double>> coefficients_of(const std::string& text)
+    {
+        const Expression expr = Expression::parse(text);
+        return {expr.coefficients().begin(), expr.coefficients().end()};
+    }
+
+    /// Runs `text` on one batch spread over a small grid and compares every lane with a Horner jet of its expansion
+    template <int Order>
+    void expect_matches_horner(const std::string& text)
+    {
+        const Expression expr = Expression::parse(text);
+        const nfract::Polynomial poly{expr.coefficients()};
+        const nfract::HornerFunction horner{poly};
+
+        std::vector<float> z_re(nfract::batch_lanes);
+        std::vector<float> z_im(nfract::batch_lanes);
+        for (int l = 0; l < nfract::batch_lanes; ++l)
+        {
+            z_re[l] = -1.2f + 0.3f * static_cast<float>(l % 8);
+            z_im[l] = -0.9f + 0.25f * static_cast<float>(l / 8);
+        }
+
+        std::vector<nfract::JetBatch<Order>> scratch(static_cast<std::size_t>(expr.registers()));
+        expr.evaluate<Order>(z_re.data(), z_im.data(), scratch);
+
+        for (int l = 0; l < nfract::batch_lanes; ++l)
+        {
+            Jet<Order> expected;
+            static_cast<void>(horner.evaluate<Order>({z_re[l], z_im[l]}, 0.0f, expected));
+            for (int k = 0; k <= Order; ++k)
+            {
+                const float scale = 1e-4f * std::max(1.0f, std::sqrt(nfract::abs2(expected[k])));
+                EXPECT_NEAR(scratch[0].re[k][l], expected[k].re, scale) << text << " lane " << l << " term " << k;
+                EXPECT_NEAR(scratch[0].im[k][l], expected[k].im, scale) << text << " lane " << l << " term " << k;
+            }
+        }
+    }
+}
+
+TEST(ExpressionTest, ExpandsToCoefficientsHighestDegreeFirst)
+{
+    using C = std::complex<double>;
+    EXPECT_EQ(coefficients_of("z^7 + 3z^2 - 1"), (std::vector<C>{1, 0, 0, 0, 0, 3, 0, -1}));
+    EXPECT_EQ(coefficients_of("(z - 1)(z + 1)"), (std::vector<C>{1, 0, -1}));
+    EXPECT_EQ(coefficients_of("-z^2 + 2i z / 2"), (std::vector<C>{-1, C{0, 1}, 0}));
+    EXPECT_EQ(coefficients_of("z^2^3 - z*z^3 + z"), (std::vector<C>{1, 0, 0, 0, -1, 0, 0, 1, 0}));
+    EXPECT_EQ(coefficients_of("(1+i) z^0 + 1.5e1 z"), (std::vector<C>{15, C{1, 1}}));
+}
+
+TEST(ExpressionTest, RejectsMalformedOrNonPolynomialText)
+{
+    for (const char* text : {"", "z +", "(z", "z)", "1/z", "z/0", "z^1.5", "z^-1", "z^z", "3", "z - z", "sin(z)", "2e", "z^2000"})
+    {
+        EXPECT_THROW(static_cast<void>(Expression::parse(text)), std::invalid_argument) << text;
+    }
+}
+
+TEST(ExpressionTest, ExpandsFamiliesAffineInTheParameter)
+{
+    using C = std::complex<double>;
+    const Expression family = Expression::parse("z^3 + (a - 1)z - a");
+
+    EXPECT_TRUE(family.has_parameter());
+    EXPECT_TRUE(family.code().empty());
+    EXPECT_EQ(std::vector<C>(family.coefficients().begin(), family.coefficients().end()), (std::vector<C>{1, 0, -1, 0}));
+    EXPECT_EQ(std::vector<C>(family.parameter_coefficients().begin(), family.parameter_coefficients().end()), (std::vector<C>{0, 0, 1, -1}));
+
+    EXPECT_FALSE(Expression::parse("z^2 - 1").has_parameter());
+    EXPECT_THROW(static_cast<void>(Expression::parse("a^2 z - 1")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(Expression::parse("(z - a)(z + a)")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(Expression::parse("z / a")), std::invalid_argument);
+}
+
+TEST(ExpressionTest, FoldsConstantsIntoImmediateOperations)
+{
+    // 3z^2 - 1: load, square, scale, offset; no register holds a constant
+    const Expression expr = Expression::parse("3z^2 - 1");
+    ASSERT_EQ(expr.code().size(), 4u);
+    EXPECT_EQ(expr.code()[0].op, Expression::Op::LOAD_Z);
+    EXPECT_EQ(expr.code()[1].op, Expression::Op::MUL);
+    EXPECT_EQ(expr.code()[2].op, Expression::Op::SCALE);
+    EXPECT_EQ(expr.code()[3].op, Expression::Op::OFFSET);
+    EXPECT_EQ(expr.registers(), 1);
+}
+
+TEST(ExpressionTest, InterpreterMatchesHornerJets)
+{
+    for (const char* text : {"z^7 + 3z^2 - 1", "(z + 1)^5 (z - 2i)^3 + z", "1 - (z - 0.5)^2 * (2 + z)", "z^13 - i"})
+    {
+        expect_matches_horner<1>(text);
+        expect_matches_horner<2>(text);
+        expect_matches_horner<3>(text);
+    }
+}
@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "core/FastMath.hpp"
+
+TEST(FastMathTest, Log2StaysWithinItsBound)
+{
+    double worst = 0.0;
+    for (float x = 1e-30f; x < 1e30f; x *= 1.0137f)
+    {
+        worst = std::max(worst, std::abs(static_cast<double>(nfract::fast_log2(x)) - std::log2(static_cast<double>(x))));
+    }
+    // 5e-8 of truncation plus the float rounding of results up to |log2 x| ~ 100
+    EXPECT_LT(worst, 1e-5);
+
+    for (const float x : {0.5f, 1.0f, 2.0f, 1024.0f, 1e-4f})
+    {
+        EXPECT_NEAR(nfract::fast_log2(x), std::log2(x), 2e-7f * std::max(1.0f, std::abs(std::log2(x)))) << x;
+    }
+}
+
+TEST(FastMathTest, CosStaysWithinItsBound)
+{
+    // 1e-7 of truncation plus float rounding, and the argument reduction rounding relative to |x|
+    double worst = 0.0;
+    for (float x = -2000.0f; x < 2000.0f; x += 0.00731f)
+    {
+        const double error = std::abs(static_cast<double>(nfract::fast_cos(x)) - std::cos(static_cast<double>(x)));
+        worst = std::max(worst, error / (2e-7 + std::abs(x) * 0x1p-23));
+    }
+    EXPECT_LT(worst, 1.0);
+}
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <numeric>
 #include <stdexcept>
 #include <string>
@@ -17,6 +19,15 @@ using nfract::test::TempFileGuard;
 
 namespace test_utils = nfract::test;
 
+namespace
+{
+    [[nodiscard]] std::string read_bytes(const std::filesystem::path& path)
+    {
+        std::ifstream in{path, std::ios::binary};
+        return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    }
+}
+
 TEST(ImageTest, DefaultConstructedImageIsEmpty)
 {
     const Image image;
@@ -106,6 +117,74 @@ TEST(ImageTest, PixelOutOfRangeThrows)
     EXPECT_THROW(static_cast<void>(const_image.pixel(0, -1)), std::out_of_range);
 }
 
+TEST(ImageTest, ViewAndSubViewsAddressTheImagePixels)
+{
+    Image image{5, 4};
+
+    const nfract::ImageView view = image.view();
+    EXPECT_TRUE(view.valid());
+    EXPECT_EQ(view.width(), 5);
+    EXPECT_EQ(view.height(), 4);
+    EXPECT_EQ(view.stride(), static_cast<std::size_t>(5 * 4));
+    EXPECT_EQ(view.pixel(3, 2), image.pixel(3, 2));
+
+    // A tile shares the image's rows, so its pixel (0, 0) is the tile's corner and its rows are a full row apart
+    const nfract::ImageView tile = view.sub(1, 1, 3, 2);
+    EXPECT_TRUE(tile.valid());
+    EXPECT_EQ(tile.stride(), view.stride());
+    EXPECT_EQ(tile.row(1), image.pixel(1, 2));
+    tile.pixel(2, 1)[0] = 42;
+    EXPECT_EQ(image.pixel(3, 2)[0], 42);
+
+    EXPECT_FALSE(nfract::ImageView{}.valid());
+    EXPECT_FALSE((nfract::ImageView{image.data(), 5, 4, 16}.valid()));
+    EXPECT_FALSE(Image{}.view().valid());
+}
+
+TEST(ImageTest, PaddedRowsStartOnCacheLines)
+{
+    EXPECT_EQ(Image::padded_stride(5), 64u);
+    EXPECT_EQ(Image::padded_stride(16), 64u);
+    EXPECT_EQ(Image::padded_stride(17), 128u);
+
+    Image image{17, 3, Image::padded_stride(17)};
+    EXPECT_EQ(image.stride(), 128u);
+    EXPECT_EQ(image.pixels().size(), 128u * 3u);
+    EXPECT_EQ(image.row(1).size(), 17u * 4u);
+    for (int y = 0; y < image.height(); ++y)
+    {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(image.row(y).data()) % Image::alignment, 0u) << "row " << y;
+    }
+    EXPECT_EQ(image.pixel(2, 1), image.data() + 128 + 8);
+    EXPECT_EQ(image.view().stride(), image.stride());
+
+    // Tight images are aligned too
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(Image{3, 3}.data()) % Image::alignment, 0u);
+
+    EXPECT_THROW(Image(4, 2, 15), std::invalid_argument);
+}
+
+TEST(ImageTest, SavePngSkipsRowPadding)
+{
+    Image tight{3, 2};
+    Image padded{3, 2, Image::padded_stride(3)};
+    for (int y = 0; y < tight.height(); ++y)
+    {
+        std::iota(tight.row(y).begin(), tight.row(y).end(), static_cast<Image::pixel_type>(y * 20));
+        std::iota(padded.row(y).begin(), padded.row(y).end(), static_cast<Image::pixel_type>(y * 20));
+    }
+    // Padding bytes are not pixels and must not reach the file
+    padded.pixels().back() = 99;
+
+    const auto tight_path = test_utils::make_unique_path("nfract-tight", ".png");
+    const auto padded_path = test_utils::make_unique_path("nfract-padded", ".png");
+    TempFileGuard tight_guard{tight_path};
+    TempFileGuard padded_guard{padded_path};
+    ASSERT_TRUE(tight.save_png(tight_path));
+    ASSERT_TRUE(padded.save_png(padded_path));
+    EXPECT_EQ(read_bytes(tight_path), read_bytes(padded_path));
+}
+
 TEST(ImageTest, SavePngFailsForEmptyImage)
 {
     const Image image;
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "core/IterationBudget.hpp"
+#include "core/RenderNewton.hpp"
+#include "core/Renderer.hpp"
+#include "../support/TestUtils.hpp"
+
+using nfract::IterationBudget;
+using nfract::IterationChoice;
+using nfract::RenderParams;
+
+namespace
+{
+    /// The whole 4 x 4 square around the roots
+    [[nodiscard]] RenderParams make_params()
+    {
+        RenderParams p = nfract::test::make_params(7, 400, 300, 100);
+        p.xmin = -2.0f;
+        p.xmax = 2.0f;
+        p.ymin = -2.0f;
+        p.ymax = 2.0f;
+        return p;
+    }
+
+    /// Pixels of the probe-sized view that converge within maxIter
+    [[nodiscard]] int converged_within(nfract::Renderer& renderer, RenderParams p, const IterationChoice& choice, const int maxIter)
+    {
+        p.width = choice.probeWidth;
+        p.height = choice.probeHeight;
+        p.maxIter = maxIter;
+        std::vector<nfract::FieldSample> field(static_cast<std::size_t>(p.width * p.height));
+        renderer.render_field(p, field.data(), static_cast<std::size_t>(p.width));
+        const float tol2 = p.tolerance * p.tolerance;
+        return static_cast<int>(std::ranges::count_if(field, [&](const auto& s) { return s.iter < maxIter && s.dist2 < tol2; }));
+    }
+}
+
+TEST(IterationBudgetTest, ChoosesTheSmallestBudgetCoveringTheTarget)
+{
+    nfract::Renderer renderer{2};
+    const RenderParams p = make_params();
+
+    const IterationChoice choice = IterationBudget::choose(renderer, p, 0.99);
+    EXPECT_GT(choice.maxIter, 1);
+    EXPECT_LT(choice.maxIter, IterationBudget::ceiling);
+    EXPECT_GE(choice.coverage, 0.99);
+    EXPECT_GT(choice.converging, 0.9);
+    EXPECT_LE(choice.probeWidth * choice.probeHeight, IterationBudget::probe_pixels * 11 / 10);
+    EXPECT_NEAR(static_cast<double>(choice.probeWidth) / choice.probeHeight, 4.0 / 3.0, 0.02);
+
+    const int all = converged_within(renderer, p, choice, IterationBudget::ceiling);
+    EXPECT_GE(converged_within(renderer, p, choice, choice.maxIter), static_cast<int>(0.99 * all));
+    EXPECT_LT(converged_within(renderer, p, choice, choice.maxIter - 1), static_cast<int>(0.99 * all + 0.5));
+}
+
+TEST(IterationBudgetTest, LargerCoverageNeedsLargerBudgets)
+{
+    nfract::Renderer renderer{1};
+    RenderParams p = make_params();
+    p.method = nfract::Method::HALLEY;
+
+    const int half = IterationBudget::choose(renderer, p, 0.5).maxIter;
+    const int most = IterationBudget::choose(renderer, p, 0.99).maxIter;
+    const int all = IterationBudget::choose(renderer, p, 1.0).maxIter;
+    EXPECT_LE(half, most);
+    EXPECT_LE(most, all);
+    EXPECT_LT(half, all);
+
+    // Halley converges in fewer steps than Newton
+    p.method = nfract::Method::NEWTON;
+    EXPECT_LT(most, IterationBudget::choose(renderer, p, 0.99).maxIter);
+}
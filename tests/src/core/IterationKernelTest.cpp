@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include "core/IterationKernel.hpp"
+#include "core/Polynomial.hpp"
+#include "core/RootsTable.hpp"
+
+using nfract::Complex;
+using nfract::Jet;
+
+namespace
+{
+    /// One step of `Rule` for family `f` at z; fails the test if either refuses
+    template <typename Rule, typename Function>
+    [[nodiscard]] Complex step_of(const Function& f, const Complex z)
+    {
+        Jet<Rule::order> fz;
+        Complex dz{};
+        EXPECT_TRUE(f.template evaluate<Rule::order>(z, 1e-12f, fz));
+        EXPECT_TRUE(Rule{}(fz, dz));
+        return dz;
+    }
+
+    template <typename Rule>
+    void expect_families_agree(const Complex z)
+    {
+        const std::vector<std::complex<double>> coefficients{1.0, 0.0, 0.0, -1.0};
+        const nfract::Polynomial poly{coefficients};
+        const nfract::RootsTable roots{3};
+
+        const Complex unity = step_of<Rule>(nfract::AutoDiff{nfract::UnityFunction{3}}, z);
+        const Complex horner = step_of<Rule>(nfract::HornerFunction{poly}, z);
+        const Complex listed = step_of<Rule>(nfract::RootsFunction{roots}, z);
+
+        EXPECT_NEAR(horner.re, unity.re, 1e-5f);
+        EXPECT_NEAR(horner.im, unity.im, 1e-5f);
+        EXPECT_NEAR(listed.re, unity.re, 1e-5f);
+        EXPECT_NEAR(listed.im, unity.im, 1e-5f);
+    }
+
+    /// |z - 1| after `steps` iterations of `Rule` on z^3 - 1 from 1.3
+    template <typename Rule>
+    [[nodiscard]] double error_after(const int steps)
+    {
+        const nfract::AutoDiff f{nfract::UnityFunction{3}};
+        Complex z{1.3f, 0.0f};
+        for (int i = 0; i < steps; ++i)
+        {
+            const Complex dz = step_of<Rule>(f, z);
+            z.re -= dz.re;
+            z.im -= dz.im;
+        }
+        return std::hypot(z.re - 1.0, z.im);
+    }
+}
+
+TEST(IterationKernelTest, FunctionFamiliesAgreeOnEveryStepRule)
+{
+    for (const Complex z : {Complex{0.6f, 0.4f}, Complex{-1.2f, 0.3f}, Complex{0.1f, -0.9f}})
+    {
+        expect_families_agree<nfract::NewtonStep>(z);
+        expect_families_agree<nfract::HalleyStep>(z);
+        expect_families_agree<nfract::SchroderStep>(z);
+        expect_families_agree<nfract::Householder3Step>(z);
+    }
+}
+
+TEST(IterationKernelTest, HigherOrderRulesConvergeFaster)
+{
+    const double newton = error_after<nfract::NewtonStep>(2);
+    const double halley = error_after<nfract::HalleyStep>(2);
+    const double householder = error_after<nfract::Householder3Step>(2);
+
+    EXPECT_LT(halley, newton);
+    EXPECT_LT(householder, halley);
+}
+
+TEST(IterationKernelTest, FamiliesReportConvergence)
+{
+    const nfract::RootsTable roots{3};
+    Jet<1> f;
+
+    EXPECT_FALSE(nfract::AutoDiff{nfract::UnityFunction{3}}.evaluate<1>({1.0f, 1e-4f}, 1e-6f, f));
+    EXPECT_TRUE(nfract::AutoDiff{nfract::UnityFunction{3}}.evaluate<1>({1.1f, 0.0f}, 1e-6f, f));
+    EXPECT_FALSE(nfract::RootsFunction{roots}.evaluate<1>({1.0f, 1e-4f}, 1e-6f, f));
+}
+
+TEST(IterationKernelTest, StepRulesRefuseAtCriticalPoints)
+{
+    // z = 0 is a critical point of z^3 - 1
+    const nfract::AutoDiff f{nfract::UnityFunction{3}};
+    Jet<3> fz;
+    ASSERT_TRUE(f.evaluate<3>({0.0f, 0.0f}, 1e-6f, fz));
+
+    Complex dz{};
+    EXPECT_FALSE(nfract::Householder3Step{}(fz, dz));
+}
+
+TEST(IterationKernelTest, NearestRootClassifiesByDistance)
+{
+    const nfract::RootsTable roots{4};
+    float dist2 = 0.0f;
+
+    EXPECT_EQ(nfract::NearestRoot{roots}.nearest({0.1f, 0.8f}, dist2), 1);
+    EXPECT_NEAR(dist2, 0.1f * 0.1f + 0.2f * 0.2f, 1e-6f);
+
+    float hue = -1.0f;
+    nfract::NearestRoot{roots}({0.1f, 0.8f}, hue, dist2);
+    EXPECT_FLOAT_EQ(hue, 0.25f);
+}
+
+TEST(IterationKernelTest, LimitArgumentHuesByAngleAndEstimatesDistance)
+{
+    // f = 2 (z - i) at z = i + 0.01: |f / f'| = 0.01, angle 90 degrees
+    nfract::Jet<1> f;
+    f[0] = {0.0f, 0.02f};
+    f[1] = {2.0f, 0.0f};
+    float hue = -1.0f;
+    float dist2 = 0.0f;
+
+    nfract::LimitArgument{f}({0.0f, 1.01f}, hue, dist2);
+    EXPECT_NEAR(hue, 0.25f, 1e-6f);
+    EXPECT_NEAR(dist2, 1e-4f, 1e-9f);
+
+    nfract::LimitArgument{f}({0.0f, -1.0f}, hue, dist2);
+    EXPECT_NEAR(hue, 0.75f, 1e-6f);
+}
+
+TEST(IterationKernelTest, ParameterFamilyStartsAtFreeCriticalPoint)
+{
+    // z^3 + (a-1) z - a has f'' = 6z, so every lane starts at 0 and evaluates its own coefficients there
+    const std::vector<std::complex<double>> base{1.0, 0.0, -1.0, 0.0};
+    const std::vector<std::complex<double>> slope{0.0, 0.0, 1.0, -1.0};
+    nfract::ParameterFamily<1> family{base, slope};
+
+    std::vector<float> a_re(nfract::batch_lanes);
+    std::vector<float> a_im(nfract::batch_lanes);
+    std::vector<float> z_re(nfract::batch_lanes);
+    std::vector<float> z_im(nfract::batch_lanes);
+    for (int l = 0; l < nfract::batch_lanes; ++l)
+    {
+        a_re[l] = 0.1f * static_cast<float>(l);
+        a_im[l] = -0.05f * static_cast<float>(l);
+    }
+    family.start(a_re.data(), a_im.data(), z_re.data(), z_im.data());
+
+    const auto& f = family.evaluate(z_re.data(), z_im.data());
+    for (int l = 0; l < nfract::batch_lanes; ++l)
+    {
+        EXPECT_FLOAT_EQ(z_re[l], 0.0f);
+        EXPECT_FLOAT_EQ(z_im[l], 0.0f);
+        // f(0) = -a, f'(0) = a - 1
+        EXPECT_FLOAT_EQ(f.re[0][l], -a_re[l]);
+        EXPECT_FLOAT_EQ(f.im[0][l], -a_im[l]);
+        EXPECT_FLOAT_EQ(f.re[1][l], a_re[l] - 1.0f);
+        EXPECT_FLOAT_EQ(f.im[1][l], a_im[l]);
+    }
+
+    // Quartic z^4 - 6 a z^2: f'' = 12 z^2 - 12 a vanishes at sqrt(a)
+    const std::vector<std::complex<double>> quartic_base{1.0, 0.0, 0.0, 0.0, 0.0};
+    const std::vector<std::complex<double>> quartic_slope{0.0, 0.0, -6.0, 0.0, 0.0};
+    nfract::ParameterFamily<1> quartic{quartic_base, quartic_slope};
+    std::ranges::fill(a_re, 4.0f);
+    std::ranges::fill(a_im, 0.0f);
+    quartic.start(a_re.data(), a_im.data(), z_re.data(), z_im.data());
+    EXPECT_NEAR(z_re[0], 2.0f, 1e-5f);
+    EXPECT_NEAR(z_im[0], 0.0f, 1e-5f);
+}
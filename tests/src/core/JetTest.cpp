@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <complex>
+
+#include "core/Jet.hpp"
+
+using nfract::Complex;
+using nfract::Jet;
+
+namespace
+{
+    void expect_near(const Complex actual, const std::complex<double> expected, const double tol)
+    {
+        EXPECT_NEAR(actual.re, expected.real(), tol);
+        EXPECT_NEAR(actual.im, expected.imag(), tol);
+    }
+}
+
+TEST(JetTest, VariableCarriesUnitDerivative)
+{
+    const auto x = Jet<2>::variable({0.5f, -1.0f});
+
+    expect_near(x[0], {0.5, -1.0}, 0.0);
+    expect_near(x[1], {1.0, 0.0}, 0.0);
+    expect_near(x[2], {0.0, 0.0}, 0.0);
+}
+
+TEST(JetTest, ProductFollowsLeibnizRule)
+{
+    // f(z) = (z + 2)(z - i) = z^2 + (2 - i) z - 2i: f' = 2z + 2 - i, f''/2 = 1
+    const Complex z{0.3f, 0.7f};
+    const auto x = Jet<3>::variable(z);
+    const auto f = (x + 2.0f) * (x - Complex{0.0f, 1.0f});
+
+    const std::complex<double> zc{0.3, 0.7};
+    expect_near(f[0], (zc + 2.0) * (zc - std::complex<double>{0.0, 1.0}), 1e-6);
+    expect_near(f[1], 2.0 * zc + std::complex<double>{2.0, -1.0}, 1e-6);
+    expect_near(f[2], {1.0, 0.0}, 1e-6);
+    expect_near(f[3], {0.0, 0.0}, 1e-6);
+}
+
+TEST(JetTest, PowerMatchesRepeatedProductAndAnalyticDerivatives)
+{
+    const Complex z{0.9f, -0.4f};
+    const auto x = Jet<3>::variable(z);
+
+    auto product = Jet<3>::constant({1.0f, 0.0f});
+    for (int i = 0; i < 7; ++i)
+    {
+        product = product * x;
+    }
+    const auto power = pow_int(x, 7);
+
+    // Taylor coefficients of z^7: z^7, 7 z^6, 21 z^5, 35 z^4
+    const std::complex<double> zc{0.9, -0.4};
+    expect_near(power[0], std::pow(zc, 7), 1e-5);
+    expect_near(power[1], 7.0 * std::pow(zc, 6), 1e-5);
+    expect_near(power[2], 21.0 * std::pow(zc, 5), 1e-5);
+    expect_near(power[3], 35.0 * std::pow(zc, 4), 1e-5);
+    for (int k = 0; k <= 3; ++k)
+    {
+        expect_near(power[k], {product[k].re, product[k].im}, 1e-5);
+    }
+}
+
+TEST(JetTest, PowerBelowOrderDropsVanishingTerms)
+{
+    const auto x = Jet<3>::variable({2.0f, 0.0f});
+    const auto square = pow_int(x, 2);
+
+    expect_near(square[0], {4.0, 0.0}, 0.0);
+    expect_near(square[1], {4.0, 0.0}, 0.0);
+    expect_near(square[2], {1.0, 0.0}, 0.0);
+    expect_near(square[3], {0.0, 0.0}, 0.0);
+    expect_near(pow_int(x, 0)[1], {0.0, 0.0}, 0.0);
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include "core/Polynomial.hpp"
+
+using nfract::Polynomial;
+
+TEST(PolynomialTest, RejectsConstantPolynomials)
+{
+    const std::vector<std::complex<double>> constant{{3.0, 0.0}};
+    const std::vector<std::complex<double>> zeros{{0.0, 0.0}, {0.0, 0.0}, {5.0, 0.0}};
+
+    EXPECT_THROW(Polynomial{constant}, std::invalid_argument);
+    EXPECT_THROW(Polynomial{zeros}, std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(Polynomial::unity(0)), std::invalid_argument);
+}
+
+TEST(PolynomialTest, DropsLeadingZerosAndSplitsComplexParts)
+{
+    const std::vector<std::complex<double>> coefficients{{0.0, 0.0}, {1.0, 2.0}, {0.0, -1.0}, {3.0, 0.0}};
+    const Polynomial poly{coefficients};
+
+    EXPECT_EQ(poly.degree(), 2);
+    ASSERT_EQ(poly.re().size(), 3u);
+    EXPECT_FLOAT_EQ(poly.re()[0], 1.0f);
+    EXPECT_FLOAT_EQ(poly.im()[0], 2.0f);
+    EXPECT_FLOAT_EQ(poly.im()[1], -1.0f);
+    EXPECT_FLOAT_EQ(poly.re()[2], 3.0f);
+}
+
+TEST(PolynomialTest, PrecomputesDerivativeCoefficients)
+{
+    // (1+2i) z^2 - i z + 3  ->  (2+4i) z - i
+    const std::vector<std::complex<double>> coefficients{{1.0, 2.0}, {0.0, -1.0}, {3.0, 0.0}};
+    const Polynomial poly{coefficients};
+
+    ASSERT_EQ(poly.derivative_re().size(), 2u);
+    EXPECT_FLOAT_EQ(poly.derivative_re()[0], 2.0f);
+    EXPECT_FLOAT_EQ(poly.derivative_im()[0], 4.0f);
+    EXPECT_FLOAT_EQ(poly.derivative_re()[1], 0.0f);
+    EXPECT_FLOAT_EQ(poly.derivative_im()[1], -1.0f);
+}
+
+TEST(PolynomialTest, UnityBuildsZToTheNMinusOne)
+{
+    const Polynomial poly = Polynomial::unity(4);
+
+    EXPECT_EQ(poly.degree(), 4);
+    EXPECT_FLOAT_EQ(poly.re().front(), 1.0f);
+    EXPECT_FLOAT_EQ(poly.re().back(), -1.0f);
+    EXPECT_FLOAT_EQ(poly.derivative_re().front(), 4.0f);
+}
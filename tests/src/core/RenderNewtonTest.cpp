@@ -2,12 +2,18 @@
 
 #include <algorithm>
 #include <array>
+#include <complex>
 #include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "app/ArgumentsParser.hpp"
 #include "core/Image.hpp"
+#include "core/Polynomial.hpp"
 #include "core/RenderNewton.hpp"
 #include "core/RootsTable.hpp"
+#include "../support/TestUtils.hpp"
 
 using nfract::Arguments;
 using nfract::ColorMode;
@@ -16,20 +22,26 @@ using nfract::RootsTable;
 
 namespace
 {
+    constexpr std::array higher_order_methods{
+        nfract::Method::HALLEY, nfract::Method::HOUSEHOLDER3, nfract::Method::SCHRODER
+    };
+
+    /// Sum of the brightest channel over the image: the classic palette dims with the iteration count
+    [[nodiscard]] long brightness(const Image& img)
+    {
+        long total = 0;
+        const auto pixels = img.pixels();
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            total += std::max({pixels[i], pixels[i + 1], pixels[i + 2]});
+        }
+        return total;
+    }
+
     [[nodiscard]] Arguments make_default_args()
     {
-        Arguments args;
-        args.degree = 3;
-        args.width = 8;
-        args.height = 6;
-        args.maxIter = 20;
-        args.xmin = -1.5f;
-        args.xmax = 1.5f;
-        args.ymin = -1.0f;
-        args.ymax = 1.0f;
-        args.tolerance = 1e-4f;
+        Arguments args = nfract::test::make_params<Arguments>(3, 8, 6, 20);
         args.outputPath.clear();
-        args.colorMode = ColorMode::CLASSIC;
         return args;
     }
 }
@@ -76,21 +88,555 @@ TEST(RenderNewtonTest, CpuRendererHandlesInvalidInputGracefully)
     EXPECT_TRUE(std::ranges::equal(before, img.pixels()));
 }
 
+TEST(RenderNewtonTest, HornerRendererMatchesUnityForZToTheNMinusOne)
+{
+    const Arguments unity_args = make_default_args();
+    const RootsTable roots{unity_args.degree};
+
+    Arguments poly_args = unity_args;
+    poly_args.form = nfract::PolynomialForm::COEFFICIENTS;
+    poly_args.coefficients = {1.0, 0.0, 0.0, -1.0};
+    const RootsTable solved_roots{nfract::Polynomial{poly_args.coefficients}};
+    ASSERT_EQ(solved_roots.size(), roots.size());
+
+    Image unity_img{unity_args.width, unity_args.height};
+    Image poly_img{poly_args.width, poly_args.height};
+    nfract::render_newton_cpu(unity_args, roots, unity_img);
+    // Same roots as the unity render so the hue assignment lines up
+    nfract::render_newton_cpu(poly_args, roots, poly_img);
+
+    const auto a = unity_img.pixels();
+    const auto b = poly_img.pixels();
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        EXPECT_LE(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])), 1) << "index " << i;
+    }
+}
+
+TEST(RenderNewtonTest, RootsRendererFindsSameBasinsAsUnity)
+{
+    const Arguments unity_args = make_default_args();
+    const RootsTable roots{unity_args.degree};
+
+    Arguments roots_args = unity_args;
+    roots_args.form = nfract::PolynomialForm::ROOTS;
+    for (int k = 0; k < roots.size(); ++k)
+    {
+        roots_args.roots.emplace_back(roots.root(k));
+    }
+
+    Image unity_img{unity_args.width, unity_args.height};
+    Image roots_img{roots_args.width, roots_args.height};
+    nfract::render_newton_cpu(unity_args, roots, unity_img);
+    nfract::render_newton_cpu(roots_args, roots, roots_img);
+
+    // The stopping rules differ (|f| < tol vs. |z - r| < tol), so compare the basin each pixel lands in, which the
+    // classic palette encodes as the dominant channel for the three roots of z^3 - 1
+    const auto dominant = [](const std::uint8_t* pix)
+    {
+        return static_cast<int>(std::max_element(pix, pix + 3) - pix);
+    };
+    for (int y = 0; y < unity_args.height; ++y)
+    {
+        for (int x = 0; x < unity_args.width; ++x)
+        {
+            EXPECT_EQ(dominant(unity_img.pixel(x, y)), dominant(roots_img.pixel(x, y))) << "pixel " << x << "," << y;
+        }
+    }
+}
+
+TEST(RenderNewtonTest, RootsRendererHandlesHighDegree)
+{
+    // 600 roots of unity: Newton's immediate basin around each has radius ~1/n, so a window well inside the one around
+    // root 0 must converge there everywhere
+    constexpr int degree = 600;
+    Arguments args = make_default_args();
+    args.width = 16;
+    args.height = 16;
+    args.xmin = 0.9993f;
+    args.xmax = 1.0007f;
+    args.ymin = -0.0007f;
+    args.ymax = 0.0007f;
+    args.form = nfract::PolynomialForm::ROOTS;
+    const RootsTable unity{degree};
+    for (int k = 0; k < degree; ++k)
+    {
+        args.roots.emplace_back(unity.root(k));
+    }
+    const RootsTable roots{args.roots};
+
+    Image img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, img);
+
+    for (int y = 0; y < args.height; ++y)
+    {
+        for (int x = 0; x < args.width; ++x)
+        {
+            // Classic palette: hue 0 (root 0) is pure red
+            const std::uint8_t* pix = img.pixel(x, y);
+            EXPECT_GT(pix[0], 0) << "pixel " << x << "," << y;
+            EXPECT_EQ(pix[1], 0) << "pixel " << x << "," << y;
+            EXPECT_EQ(pix[2], 0) << "pixel " << x << "," << y;
+        }
+    }
+}
+
+TEST(RenderNewtonTest, HigherOrderMethodsConvergeInFewerIterations)
+{
+    Arguments args = make_default_args();
+    args.degree = 5;
+    args.width = 32;
+    args.height = 32;
+    args.maxIter = 100;
+    args.tolerance = 1e-5f;
+    const RootsTable roots{args.degree};
+
+    Image newton_img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, newton_img);
+
+    for (const nfract::Method method : {nfract::Method::HALLEY, nfract::Method::HOUSEHOLDER3})
+    {
+        args.method = method;
+        Image img{args.width, args.height};
+        nfract::render_newton_cpu(args, roots, img);
+        EXPECT_GT(brightness(img), brightness(newton_img)) << "method " << static_cast<int>(method);
+    }
+}
+
+TEST(RenderNewtonTest, SchroderConvergesFasterAtDoubleRoot)
+{
+    // (z - 1)^2 (z + 1): Newton is only linear at the double root, Schroder stays quadratic
+    Arguments args = make_default_args();
+    args.maxIter = 100;
+    args.form = nfract::PolynomialForm::ROOTS;
+    args.roots = {1.0, 1.0, -1.0};
+    const RootsTable roots{args.roots};
+
+    Image newton_img{args.width, args.height};
+    Image schroder_img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, newton_img);
+    args.method = nfract::Method::SCHRODER;
+    nfract::render_newton_cpu(args, roots, schroder_img);
+
+    EXPECT_GT(brightness(schroder_img), brightness(newton_img));
+}
+
+TEST(RenderNewtonTest, HigherOrderHornerRendererMatchesUnity)
+{
+    for (const nfract::Method method : higher_order_methods)
+    {
+        Arguments unity_args = make_default_args();
+        unity_args.method = method;
+        const RootsTable roots{unity_args.degree};
+
+        Arguments poly_args = unity_args;
+        poly_args.form = nfract::PolynomialForm::COEFFICIENTS;
+        poly_args.coefficients = {1.0, 0.0, 0.0, -1.0};
+
+        Image unity_img{unity_args.width, unity_args.height};
+        Image poly_img{poly_args.width, poly_args.height};
+        nfract::render_newton_cpu(unity_args, roots, unity_img);
+        nfract::render_newton_cpu(poly_args, roots, poly_img);
+
+        const auto a = unity_img.pixels();
+        const auto b = poly_img.pixels();
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            EXPECT_LE(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])), 1) << "method " << static_cast<int>(method) << " index " << i;
+        }
+    }
+}
+
+TEST(RenderNewtonTest, ScalingThePolynomialLeavesTheImageUnchanged)
+{
+    // Scaling f scales f' alike, so the Newton steps and the convergence test are the same; only the rounding of the
+    // scaled coefficients differs, which may move a pixel on the edge of the tolerance by one iteration
+    Arguments args = make_default_args();
+    args.width = 96;
+    args.height = 64;
+    args.maxIter = 40;
+    args.form = nfract::PolynomialForm::COEFFICIENTS;
+
+    // z^3 - 1, and (z - 0.9)(z - 1.1) whose |f'| at the roots is 0.2
+    const std::vector<std::pair<std::vector<std::complex<double>>, std::string>> polynomials{
+        {{1.0, 0.0, 0.0, -1.0}, "z^3 - 1"},
+        {{1.0, -2.0, 0.99}, "z^2 - 2z + 0.99"},
+    };
+    for (const auto& [coefficients, text] : polynomials)
+    {
+        args.coefficients = coefficients;
+        Image expected{args.width, args.height};
+        nfract::render_newton_cpu(args, nfract::PreparedPolynomial::prepare(args), nfract::PixelRect::frame(args), expected.view());
+
+        for (const double scale : {0.01, 0.015625, 100.0})
+        {
+            Arguments scaled = args;
+            std::ranges::for_each(scaled.coefficients, [scale](auto& c) { c *= scale; });
+            Arguments certified = scaled;
+            certified.certifyTiles = true;
+            Arguments expression = scaled;
+            expression.form = nfract::PolynomialForm::EXPRESSION;
+            expression.expression = std::to_string(scale) + " (" + text + ")";
+
+            for (const Arguments* variant : {&scaled, &certified, &expression})
+            {
+                Image actual{args.width, args.height};
+                nfract::render_newton_cpu(*variant, nfract::PreparedPolynomial::prepare(*variant), nfract::PixelRect::frame(args), actual.view());
+
+                const auto a = expected.pixels();
+                const auto b = actual.pixels();
+                for (std::size_t i = 0; i < a.size(); ++i)
+                {
+                    ASSERT_LE(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])), 255 / args.maxIter + 1)
+                        << "scale " << scale << ", form " << static_cast<int>(variant->form) << ", index " << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(RenderNewtonTest, CertifiedTilesLeaveTheImageUnchanged)
+{
+    Arguments unity = make_default_args();
+    unity.degree = 5;
+    unity.width = 240;
+    unity.height = 150;
+    unity.maxIter = 60;
+    unity.xmin = -2.0f;
+    unity.xmax = 2.0f;
+    unity.ymin = -1.25f;
+    unity.ymax = 1.25f;
+    Arguments short_budget = unity;
+    short_budget.maxIter = 6;
+    Arguments zoomed = unity;
+    zoomed.xmin = 0.55f;
+    zoomed.xmax = 0.75f;
+    zoomed.ymin = 0.35f;
+    zoomed.ymax = 0.475f;
+    Arguments coefficients = nfract::test::as_coefficients(unity);
+
+    for (const Arguments* args : {&unity, &short_budget, &zoomed, &coefficients})
+    {
+        const nfract::PreparedPolynomial prepared = nfract::PreparedPolynomial::prepare(*args);
+        Arguments certified = *args;
+        certified.certifyTiles = true;
+
+        for (const nfract::PixelRect region : {nfract::PixelRect::frame(*args), nfract::PixelRect{37, 21, 101, 67}})
+        {
+            const std::size_t stride = static_cast<std::size_t>(region.width) * 4u;
+            std::vector<std::uint8_t> expected(stride * static_cast<std::size_t>(region.height));
+            std::vector<std::uint8_t> actual(expected.size(), std::uint8_t{17});
+            nfract::render_newton_cpu(*args, prepared, region, nfract::ImageView{expected.data(), region.width, region.height, stride});
+            nfract::render_newton_cpu(certified, prepared, region, nfract::ImageView{actual.data(), region.width, region.height, stride});
+            EXPECT_EQ(actual, expected) << "degree " << args->degree << ", max-iter " << args->maxIter;
+        }
+    }
+}
+
+TEST(RenderNewtonTest, EqualizedPaletteSpreadsBrightnessEvenly)
+{
+    const std::vector<std::uint32_t> counts{0, 2, 0, 2};
+    std::vector<float> ranks(counts.size());
+    nfract::equalize(counts, ranks);
+    EXPECT_EQ(ranks, (std::vector<float>{0.0f, 0.25f, 0.5f, 0.75f}));
+
+    Arguments args = make_default_args();
+    args.width = 160;
+    args.height = 120;
+    args.maxIter = 60;
+    const RootsTable roots{args.degree};
+
+    // Brightness of the converged pixels: the classic palette crowds them at the bright end, the equalized one
+    // spreads them over [0.15, 1], so about half land above the middle of that range
+    const auto share_above_middle = [&](const ColorMode mode)
+    {
+        args.colorMode = mode;
+        Image img{args.width, args.height};
+        nfract::render_newton_cpu(args, roots, img);
+        int converged = 0;
+        int above = 0;
+        const auto pixels = img.pixels();
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            const int value = std::max({pixels[i], pixels[i + 1], pixels[i + 2]});
+            converged += value > 0 ? 1 : 0;
+            above += value > static_cast<int>(0.575f * 255.0f) ? 1 : 0;
+        }
+        return static_cast<double>(above) / static_cast<double>(converged);
+    };
+
+    EXPECT_NEAR(share_above_middle(ColorMode::EQUALIZED), 0.5, 0.1);
+    EXPECT_GT(share_above_middle(ColorMode::CLASSIC), 0.8);
+}
+
+TEST(RenderNewtonTest, FastMathShadingStaysWithinOneStepPerChannel)
+{
+    Arguments args = make_default_args();
+    args.degree = 5;
+    args.width = 160;
+    args.height = 120;
+    args.maxIter = 200;
+    args.xmin = -2.0f;
+    args.xmax = 2.0f;
+    args.ymin = -1.5f;
+    args.ymax = 1.5f;
+    const RootsTable roots{args.degree};
+
+    for (const ColorMode mode : {ColorMode::NEON, ColorMode::JEWELRY})
+    {
+        args.colorMode = mode;
+        args.fastShading = false;
+        Image exact{args.width, args.height};
+        nfract::render_newton_cpu(args, roots, exact);
+        args.fastShading = true;
+        Image fast{args.width, args.height};
+        nfract::render_newton_cpu(args, roots, fast);
+
+        int deviation = 0;
+        for (std::size_t i = 0; i < exact.pixels().size(); ++i)
+        {
+            deviation = std::max(deviation, std::abs(static_cast<int>(exact.pixels()[i]) - static_cast<int>(fast.pixels()[i])));
+        }
+        EXPECT_LE(deviation, 1) << "mode " << static_cast<int>(mode);
+    }
+}
+
+TEST(RenderNewtonTest, ShadedFieldMatchesDirectRender)
+{
+    Arguments args = make_default_args();
+    args.degree = 5;
+    args.width = 300;
+    args.height = 40;
+    args.maxIter = 100;
+    const auto prepared = nfract::PreparedPolynomial::prepare(args);
+    const nfract::PixelRect frame = nfract::PixelRect::frame(args);
+    std::vector<nfract::FieldSample> field(static_cast<std::size_t>(args.width * args.height));
+    nfract::render_field_cpu(args, prepared, frame, field.data(), static_cast<std::size_t>(args.width));
+
+    // 300 pixels a row: neon with --fast-math-shading is shaded in one full run of planes and a short one
+    for (const ColorMode mode : {ColorMode::CLASSIC, ColorMode::JEWELRY, ColorMode::NEON})
+    {
+        for (const bool fast : {false, true})
+        {
+            args.colorMode = mode;
+            args.fastShading = fast;
+            // The direct render colours each pixel as it stops; the field is coloured row by row
+            Image direct{args.width, args.height};
+            nfract::render_newton_cpu(args, prepared, frame, direct.view());
+            Image rgba{args.width, args.height};
+            nfract::shade_field(args, frame, field.data(), static_cast<std::size_t>(args.width), rgba.view());
+
+            EXPECT_TRUE(std::ranges::equal(direct.pixels(), rgba.pixels())) << "mode " << static_cast<int>(mode) << " fast " << fast;
+        }
+    }
+}
+
+TEST(RenderNewtonTest, ExpressionRendererMatchesHorner)
+{
+    // The interpreter computes the same jets in a different order, so a pixel on the edge of the tolerance may stop one
+    // iteration apart: allow one step of the classic palette's brightness ramp
+    for (const nfract::Method method : {nfract::Method::NEWTON, nfract::Method::HALLEY, nfract::Method::HOUSEHOLDER3, nfract::Method::SCHRODER})
+    {
+        Arguments expr_args = nfract::test::as_expression(make_default_args());
+        expr_args.width = 70; // more than one interpreter batch per row, the last one short
+        expr_args.method = method;
+
+        const Arguments poly_args = nfract::test::as_coefficients(expr_args);
+        const RootsTable roots{nfract::Polynomial{poly_args.coefficients}};
+
+        Image expr_img{expr_args.width, expr_args.height};
+        Image poly_img{poly_args.width, poly_args.height};
+        nfract::render_newton_cpu(expr_args, roots, expr_img);
+        nfract::render_newton_cpu(poly_args, roots, poly_img);
+
+        const auto a = expr_img.pixels();
+        const auto b = poly_img.pixels();
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            EXPECT_LE(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])), 255 / expr_args.maxIter + 1) << "method " << static_cast<int>(method) << " index " << i;
+        }
+    }
+}
+
+TEST(RenderNewtonTest, FamilyRendererColoursParameterPlane)
+{
+    // z^3 + (a-1) z - a = (z - 1)(z^2 + z + a): at a = 0 the critical orbit starts on the root z = 0 and converges at once,
+    // so the centre pixel is brightly lit. Each pixel gets its own coefficients, so rendering twice is deterministic.
+    Arguments args = make_default_args();
+    args.width = 71; // more than one batch per row, the last one short
+    args.height = 5;
+    args.form = nfract::PolynomialForm::FAMILY;
+    args.coefficients = {{1.0, 0.0}, {0.0, 0.0}, {-1.0, 0.0}, {0.0, 0.0}};
+    args.parameterCoefficients = {{0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}, {-1.0, 0.0}};
+    args.xmin = -0.7f;
+    args.xmax = 0.7f;
+    args.ymin = -0.1f;
+    args.ymax = 0.1f;
+    const RootsTable roots{};
+
+    Image img{args.width, args.height};
+    Image again{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, img);
+    nfract::render_newton_cpu(args, roots, again);
+
+    EXPECT_TRUE(std::ranges::equal(img.pixels(), again.pixels()));
+    const std::size_t centre = (static_cast<std::size_t>(args.height / 2) * args.width + args.width / 2) * 4;
+    const auto pixels = img.pixels();
+    EXPECT_GT(std::max({pixels[centre], pixels[centre + 1], pixels[centre + 2]}), 200);
+}
+
+TEST(RenderNewtonTest, FamilyRendererSkipsFamiliesItCannotIterate)
+{
+    // The per-pixel coefficients only hold cubics and quartics, with one coefficient of a per coefficient
+    Arguments too_high = make_default_args();
+    too_high.form = nfract::PolynomialForm::FAMILY;
+    too_high.coefficients.assign(9, {1.0, 0.0});
+    too_high.parameterCoefficients.assign(9, {0.5, 0.0});
+    Arguments mismatched = too_high;
+    mismatched.coefficients = {{1.0, 0.0}, {0.0, 0.0}, {-1.0, 0.0}, {0.0, 0.0}};
+    mismatched.parameterCoefficients = {{1.0, 0.0}, {-1.0, 0.0}};
+
+    for (const Arguments* args : {&too_high, &mismatched})
+    {
+        const nfract::PreparedPolynomial prepared = nfract::PreparedPolynomial::prepare(*args);
+        EXPECT_TRUE(prepared.family.base_re.empty());
+
+        Image img{args->width, args->height};
+        const auto before = img.pixels();
+        nfract::render_newton_cpu(*args, prepared, nfract::PixelRect::frame(*args), img.view());
+        EXPECT_TRUE(std::ranges::equal(before, img.pixels()));
+    }
+}
+
+TEST(RenderNewtonTest, DoubleDoubleRendererResolvesDeepZoom)
+{
+    // A 2e-22 wide window straddling the boundary between two basins of z^3 - 1: every float and
+    // double pixel coordinate collapses to the same value here, double-double keeps them apart.
+    Arguments args = make_default_args();
+    args.width = 16;
+    args.height = 16;
+    args.maxIter = 200;
+    args.precision = nfract::Precision::DOUBLE_DOUBLE;
+    args.xminDecimal = "0.10744364377429714565413912494528";
+    args.xmaxDecimal = "0.10744364377429714565413912494548";
+    args.yminDecimal = "0.49999999999999999999990";
+    args.ymaxDecimal = "0.50000000000000000000010";
+    const RootsTable roots{args.degree};
+
+    Image img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, img);
+
+    const auto pixels = img.pixels();
+    bool distinct = false;
+    for (std::size_t i = 4; i < pixels.size() && !distinct; i += 4)
+    {
+        distinct = !std::equal(pixels.begin(), pixels.begin() + 3, pixels.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    EXPECT_TRUE(distinct) << "Deep zoom collapsed to a single color";
+}
+
+TEST(RenderNewtonTest, DoubleDoubleRendererMatchesSinglePrecisionAtShallowZoom)
+{
+    Arguments args = make_default_args();
+    args.xmin = -1.25f;
+    args.xmax = 1.25f;
+    args.ymin = -1.0f;
+    args.ymax = 1.0f;
+    const RootsTable roots{args.degree};
+
+    Image single_img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, single_img);
+
+    args.precision = nfract::Precision::DOUBLE_DOUBLE;
+    Image dd_img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, dd_img);
+
+    // Pixels well inside a basin converge the same way; only iteration counts may shift by one
+    const auto a = single_img.pixels();
+    const auto b = dd_img.pixels();
+    ASSERT_EQ(a.size(), b.size());
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        if (std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])) > 16)
+        {
+            ++mismatches;
+        }
+    }
+    EXPECT_LE(mismatches, a.size() / 20);
+}
+
+TEST(RenderNewtonTest, PerturbationRendererMatchesDoubleDouble)
+{
+    Arguments args = make_default_args();
+    args.width = 24;
+    args.height = 16;
+    args.maxIter = 400;
+    args.xminDecimal = "0.10744364377429714565413912494";
+    args.xmaxDecimal = "0.10744364377429714565413912504";
+    args.yminDecimal = "0.49999999999999999999999999995";
+    args.ymaxDecimal = "0.50000000000000000000000000005";
+    const RootsTable roots{args.degree};
+
+    args.precision = nfract::Precision::DOUBLE_DOUBLE;
+    Image dd_img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, dd_img);
+
+    args.precision = nfract::Precision::PERTURBATION;
+    Image perturb_img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, perturb_img);
+
+    const auto a = dd_img.pixels();
+    const auto b = perturb_img.pixels();
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        mismatches += std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])) > 16 ? 1 : 0;
+    }
+    EXPECT_LE(mismatches, a.size() / 50);
+}
+
+TEST(RenderNewtonTest, PerturbationRendererResolvesZoomBeyondDoubleDouble)
+{
+    Arguments args = make_default_args();
+    args.width = 16;
+    args.height = 16;
+    args.maxIter = 300;
+    args.precision = nfract::Precision::PERTURBATION;
+    args.xminDecimal = "0.10744364377429714565413912494528179538485373270220144822948740";
+    args.xmaxDecimal = "0.10744364377429714565413912494528179538485373270220144822948749";
+    args.yminDecimal = "0.49999999999999999999999999999999999999999999999999999999999995";
+    args.ymaxDecimal = "0.50000000000000000000000000000000000000000000000000000000000005";
+    const RootsTable roots{args.degree};
+
+    Image img{args.width, args.height};
+    std::fill(img.pixels().begin(), img.pixels().end(), std::uint8_t{17});
+    nfract::render_newton_cpu(args, roots, img);
+
+    const auto pixels = img.pixels();
+    bool distinct = false;
+    for (std::size_t i = 4; i < pixels.size(); i += 4)
+    {
+        EXPECT_EQ(pixels[i + 3], 255) << "Pixel " << i / 4 << " was never written";
+        distinct = distinct || !std::equal(pixels.begin(), pixels.begin() + 3, pixels.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    EXPECT_TRUE(distinct) << "1e-61 window collapsed to a single color";
+}
+
 #ifndef RUN_ON_CPU
 TEST(RenderNewtonTest, IspcRendererMatchesCpuOutput)
 {
     const Arguments base_args = make_default_args();
     const RootsTable roots{base_args.degree};
-    constexpr std::array modes{
-        ColorMode::CLASSIC, ColorMode::JEWELRY, ColorMode::NEON
-    };
 
     constexpr int kChannelTolerance = 1;
 
-    for (const ColorMode mode : modes)
+    for (const auto [mode, fast] : {std::pair{ColorMode::CLASSIC, false}, std::pair{ColorMode::JEWELRY, false}, std::pair{ColorMode::NEON, false},
+                                    std::pair{ColorMode::JEWELRY, true}, std::pair{ColorMode::NEON, true}})
     {
         Arguments args = base_args;
         args.colorMode = mode;
+        args.fastShading = fast;
 
         Image cpu_img{args.width, args.height};
         Image ispc_img{args.width, args.height};
@@ -129,4 +675,187 @@ TEST(RenderNewtonTest, IspcRendererMatchesCpuOutput)
             << "CPU and ISPC renderers should produce identical RGBA output for the same parameters";
     }
 }
+
+TEST(RenderNewtonTest, IspcHornerRendererMatchesCpuOutput)
+{
+    const Arguments args = nfract::test::as_coefficients(make_default_args());
+    const RootsTable roots{nfract::Polynomial{args.coefficients}};
+
+    Image cpu_img{args.width, args.height};
+    Image ispc_img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, cpu_img);
+    nfract::render_newton_ispc(args, roots, ispc_img);
+
+    const auto cpu_pixels = cpu_img.pixels();
+    const auto ispc_pixels = ispc_img.pixels();
+    for (std::size_t i = 0; i < cpu_pixels.size(); ++i)
+    {
+        EXPECT_LE(std::abs(static_cast<int>(cpu_pixels[i]) - static_cast<int>(ispc_pixels[i])), 1) << "index " << i;
+    }
+}
+
+TEST(RenderNewtonTest, IspcRootsRendererMatchesCpuOutput)
+{
+    Arguments args = make_default_args();
+    args.form = nfract::PolynomialForm::ROOTS;
+    args.roots = {{1.0, 0.0}, {-0.5, 0.8}, {-0.5, -0.8}, {0.2, 0.1}};
+    const RootsTable roots{args.roots};
+
+    Image cpu_img{args.width, args.height};
+    Image ispc_img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, cpu_img);
+    nfract::render_newton_ispc(args, roots, ispc_img);
+
+    const auto cpu_pixels = cpu_img.pixels();
+    const auto ispc_pixels = ispc_img.pixels();
+    for (std::size_t i = 0; i < cpu_pixels.size(); ++i)
+    {
+        EXPECT_LE(std::abs(static_cast<int>(cpu_pixels[i]) - static_cast<int>(ispc_pixels[i])), 1) << "index " << i;
+    }
+}
+
+TEST(RenderNewtonTest, IspcExpressionRendererMatchesCpuOutput)
+{
+    for (const nfract::Method method : {nfract::Method::NEWTON, nfract::Method::HALLEY, nfract::Method::HOUSEHOLDER3, nfract::Method::SCHRODER})
+    {
+        Arguments args = nfract::test::as_expression(make_default_args());
+        args.method = method;
+        const RootsTable roots{nfract::Polynomial{args.coefficients}};
+
+        Image cpu_img{args.width, args.height};
+        Image ispc_img{args.width, args.height};
+        nfract::render_newton_cpu(args, roots, cpu_img);
+        nfract::render_newton_ispc(args, roots, ispc_img);
+
+        // As in ExpressionRendererMatchesHorner, edge pixels may stop one iteration apart
+        const auto cpu_pixels = cpu_img.pixels();
+        const auto ispc_pixels = ispc_img.pixels();
+        for (std::size_t i = 0; i < cpu_pixels.size(); ++i)
+        {
+            EXPECT_LE(std::abs(static_cast<int>(cpu_pixels[i]) - static_cast<int>(ispc_pixels[i])), 255 / args.maxIter + 1) << "method " << static_cast<int>(method) << " index " << i;
+        }
+    }
+}
+
+TEST(RenderNewtonTest, IspcFamilyRendererMatchesCpuOutput)
+{
+    Arguments args = make_default_args();
+    args.form = nfract::PolynomialForm::FAMILY;
+    args.coefficients = {{1.0, 0.0}, {0.0, 0.0}, {-1.0, 0.0}, {0.0, 0.0}};
+    args.parameterCoefficients = {{0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}, {-1.0, 0.0}};
+    const RootsTable roots{};
+
+    Image cpu_img{args.width, args.height};
+    Image ispc_img{args.width, args.height};
+    nfract::render_newton_cpu(args, roots, cpu_img);
+    nfract::render_newton_ispc(args, roots, ispc_img);
+
+    // As in ExpressionRendererMatchesHorner, edge pixels may stop one iteration apart
+    const auto cpu_pixels = cpu_img.pixels();
+    const auto ispc_pixels = ispc_img.pixels();
+    for (std::size_t i = 0; i < cpu_pixels.size(); ++i)
+    {
+        EXPECT_LE(std::abs(static_cast<int>(cpu_pixels[i]) - static_cast<int>(ispc_pixels[i])), 255 / args.maxIter + 1) << "index " << i;
+    }
+}
+
+TEST(RenderNewtonTest, IspcHigherOrderRenderersMatchCpuOutput)
+{
+    Arguments unity_args = make_default_args();
+    Arguments poly_args = nfract::test::as_coefficients(unity_args);
+    Arguments roots_args = unity_args;
+    roots_args.form = nfract::PolynomialForm::ROOTS;
+    roots_args.roots = {{1.0, 0.0}, {-0.5, 0.8}, {-0.5, -0.8}, {0.2, 0.1}};
+
+    const RootsTable unity_roots{unity_args.degree};
+    const RootsTable poly_roots{nfract::Polynomial{poly_args.coefficients}};
+    const RootsTable listed_roots{roots_args.roots};
+    const std::array cases{
+        std::pair{&unity_args, &unity_roots}, std::pair{&poly_args, &poly_roots}, std::pair{&roots_args, &listed_roots}
+    };
+
+    for (const nfract::Method method : higher_order_methods)
+    {
+        for (const auto& [args, roots] : cases)
+        {
+            args->method = method;
+            Image cpu_img{args->width, args->height};
+            Image ispc_img{args->width, args->height};
+            nfract::render_newton_cpu(*args, *roots, cpu_img);
+            nfract::render_newton_ispc(*args, *roots, ispc_img);
+
+            const auto cpu_pixels = cpu_img.pixels();
+            const auto ispc_pixels = ispc_img.pixels();
+            for (std::size_t i = 0; i < cpu_pixels.size(); ++i)
+            {
+                EXPECT_LE(std::abs(static_cast<int>(cpu_pixels[i]) - static_cast<int>(ispc_pixels[i])), 1)
+                    << "method " << static_cast<int>(method) << " form " << static_cast<int>(args->form) << " index " << i;
+            }
+        }
+    }
+}
+
+TEST(RenderNewtonTest, IspcExtendedPrecisionRenderersMatchCpuOutput)
+{
+    for (const auto precision : {nfract::Precision::DOUBLE_DOUBLE, nfract::Precision::PERTURBATION})
+    {
+        Arguments args = make_default_args();
+        args.precision = precision;
+        const RootsTable roots{args.degree};
+
+        Image cpu_img{args.width, args.height};
+        Image ispc_img{args.width, args.height};
+        nfract::render_newton_cpu(args, roots, cpu_img);
+        nfract::render_newton_ispc(args, roots, ispc_img);
+
+        const auto cpu_pixels = cpu_img.pixels();
+        const auto ispc_pixels = ispc_img.pixels();
+        ASSERT_EQ(cpu_pixels.size(), ispc_pixels.size());
+        for (std::size_t i = 0; i < cpu_pixels.size(); ++i)
+        {
+            EXPECT_LE(std::abs(static_cast<int>(cpu_pixels[i]) - static_cast<int>(ispc_pixels[i])), 1)
+                << "precision " << static_cast<int>(precision) << " index " << i;
+        }
+    }
+}
+
+TEST(RenderNewtonTest, IspcRegionMatchesAtAnyByteAlignment)
+{
+    Arguments args = make_default_args();
+    args.width = 37;
+    const auto prepared = nfract::PreparedPolynomial::prepare(args);
+    const nfract::PixelRect region{3, 1, 29, 4};
+
+    // Word-aligned rows take the packed stores; an odd base or stride falls back to bytes
+    const std::size_t tight = static_cast<std::size_t>(region.width) * 4;
+    std::vector<std::uint8_t> aligned(tight * static_cast<std::size_t>(region.height));
+    ASSERT_TRUE(nfract::render_newton_ispc_region(args, prepared, region, nfract::ImageView{aligned.data(), region.width, region.height, tight}));
+
+    const std::size_t stride = tight + 3;
+    std::vector<std::uint8_t> unaligned(1 + stride * static_cast<std::size_t>(region.height));
+    ASSERT_TRUE(nfract::render_newton_ispc_region(args, prepared, region, nfract::ImageView{unaligned.data() + 1, region.width, region.height, stride}));
+
+    for (int y = 0; y < region.height; ++y)
+    {
+        const std::uint8_t* expected = aligned.data() + static_cast<std::size_t>(y) * tight;
+        const std::uint8_t* actual = unaligned.data() + 1 + static_cast<std::size_t>(y) * stride;
+        EXPECT_TRUE(std::equal(expected, expected + tight, actual)) << "row " << y;
+    }
+}
+TEST(RenderNewtonTest, IspcCertifiedRenderMatchesCertifiedCpuRender)
+{
+    Arguments args = make_default_args();
+    args.width = 61;
+    args.height = 47;
+    args.certifyTiles = true;
+    const auto prepared = nfract::PreparedPolynomial::prepare(args);
+    const nfract::PixelRect region{5, 3, 40, 30};
+
+    const std::size_t stride = static_cast<std::size_t>(region.width) * 4;
+    std::vector<std::uint8_t> expected(stride * static_cast<std::size_t>(region.height));
+    std::vector<std::uint8_t> actual(expected.size(), std::uint8_t{17});
+    nfract::render_newton_cpu(args, prepared, region, nfract::ImageView{expected.data(), region.width, region.height, stride});
+    ASSERT_TRUE(nfract::render_newton_ispc_region(args, prepared, region, nfract::ImageView{actual.data(), region.width, region.height, stride}));
+    EXPECT_EQ(actual, expected);
+}
 #endif
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "core/Image.hpp"
+#include "core/RenderNewton.hpp"
+#include "core/RenderState.hpp"
+#include "core/Renderer.hpp"
+#include "../support/TestUtils.hpp"
+
+using nfract::FieldSample;
+using nfract::Image;
+using nfract::RenderParams;
+using nfract::RenderState;
+
+namespace
+{
+    /// A budget of 8 leaves pixels to resume in every form
+    [[nodiscard]] RenderParams make_params()
+    {
+        return nfract::test::make_params(6, 70, 41, 8);
+    }
+
+    [[nodiscard]] std::vector<FieldSample> render_field(nfract::Renderer& renderer, const RenderParams& p)
+    {
+        std::vector<FieldSample> field(static_cast<std::size_t>(p.width * p.height));
+        renderer.render_field(p, field.data(), static_cast<std::size_t>(p.width));
+        return field;
+    }
+
+    [[nodiscard]] Image shade(const RenderParams& p, const std::vector<FieldSample>& field)
+    {
+        Image img{p.width, p.height};
+        nfract::shade_field(p, nfract::PixelRect::frame(p), field.data(), static_cast<std::size_t>(p.width), img.view());
+        return img;
+    }
+
+    [[nodiscard]] Image reference(const RenderParams& p)
+    {
+        Image img{p.width, p.height};
+        nfract::render_newton_cpu(p, nfract::PreparedPolynomial::prepare(p).roots, img);
+        return img;
+    }
+}
+
+TEST(RenderStateTest, FieldRenderShadesLikeADirectRender)
+{
+    nfract::Renderer renderer{2};
+    RenderParams p = make_params();
+    p.maxIter = 40;
+    for (const auto palette : {nfract::ColorMode::CLASSIC, nfract::ColorMode::NEON, nfract::ColorMode::JEWELRY})
+    {
+        p.colorMode = palette;
+        EXPECT_TRUE(std::ranges::equal(shade(p, render_field(renderer, p)).pixels(), reference(p).pixels()));
+    }
+}
+
+TEST(RenderStateTest, ResumingMatchesRenderingWithTheLargerBudget)
+{
+    nfract::Renderer renderer{2};
+
+    for (const RenderParams& p : nfract::test::every_form(make_params()))
+    {
+        std::vector<FieldSample> field = render_field(renderer, p);
+        const RenderState first{p, field};
+        ASSERT_GT(first.unconverged(), 0) << "form " << static_cast<int>(p.form);
+
+        RenderParams deeper = p;
+        deeper.maxIter = 60;
+        renderer.render_field(deeper, field.data(), static_cast<std::size_t>(p.width), p.maxIter);
+
+        const std::vector<FieldSample> expected = render_field(renderer, deeper);
+        for (std::size_t i = 0; i < field.size(); ++i)
+        {
+            ASSERT_EQ(field[i].iter, expected[i].iter) << "form " << static_cast<int>(p.form) << " sample " << i;
+            ASSERT_EQ(field[i].hue, expected[i].hue) << "form " << static_cast<int>(p.form) << " sample " << i;
+            ASSERT_EQ(field[i].dist2, expected[i].dist2) << "form " << static_cast<int>(p.form) << " sample " << i;
+        }
+        EXPECT_LT(RenderState(deeper, field).unconverged(), first.unconverged());
+    }
+}
+
+TEST(RenderStateTest, SavesAndLoadsTheField)
+{
+    nfract::Renderer renderer{1};
+    const RenderParams p = make_params();
+    const RenderState saved{p, render_field(renderer, p)};
+
+    const auto path = std::filesystem::temp_directory_path() / "nfract_render_state_test.bin";
+    ASSERT_TRUE(saved.save(path));
+    RenderState loaded = RenderState::load(path);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(loaded.max_iter(), p.maxIter);
+    EXPECT_EQ(loaded.unconverged(), saved.unconverged());
+    ASSERT_EQ(loaded.field().size(), saved.field().size());
+    for (std::size_t i = 0; i < loaded.field().size(); ++i)
+    {
+        const FieldSample& a = loaded.field()[i];
+        const FieldSample& b = saved.field()[i];
+        ASSERT_EQ(a.iter, b.iter);
+        ASSERT_EQ(a.hue, b.hue);
+        ASSERT_EQ(a.dist2, b.dist2);
+        if (a.iter == p.maxIter)
+        {
+            ASSERT_EQ(a.zre, b.zre);
+            ASSERT_EQ(a.zim, b.zim);
+        }
+    }
+
+    // The loaded state resumes like the original
+    RenderParams deeper = p;
+    deeper.maxIter = 50;
+    deeper.colorMode = nfract::ColorMode::JEWELRY;
+    ASSERT_TRUE(loaded.resumable_by(deeper));
+    renderer.render_field(deeper, loaded.field().data(), static_cast<std::size_t>(p.width), loaded.max_iter());
+    EXPECT_TRUE(std::ranges::equal(shade(deeper, loaded.field()).pixels(), reference(deeper).pixels()));
+}
+
+TEST(RenderStateTest, ResumesOnlyTheSameField)
+{
+    const RenderParams p = make_params();
+    const RenderState state{p, std::vector<FieldSample>(static_cast<std::size_t>(p.width * p.height))};
+
+    EXPECT_TRUE(state.resumable_by(p));
+    RenderParams other = p;
+    other.maxIter = p.maxIter - 1;
+    EXPECT_FALSE(state.resumable_by(other));
+    other = p;
+    other.xmax = 1.25f;
+    EXPECT_FALSE(state.resumable_by(other));
+    other = p;
+    other.degree = 7;
+    EXPECT_FALSE(state.resumable_by(other));
+    other = p;
+    other.method = nfract::Method::HALLEY;
+    EXPECT_FALSE(state.resumable_by(other));
+}
+
+TEST(RenderStateTest, RejectsFieldsOfAnotherSize)
+{
+    const RenderParams p = make_params();
+    const RenderState short_state{p, std::vector<FieldSample>(static_cast<std::size_t>(p.width * p.height) - 1)};
+    EXPECT_FALSE(short_state.resumable_by(p));
+
+    // A file whose samples do not fill the frame in its key would be resumed out of bounds
+    const auto path = std::filesystem::temp_directory_path() / "nfract_render_state_short.bin";
+    ASSERT_TRUE(short_state.save(path));
+    EXPECT_THROW(static_cast<void>(RenderState::load(path)), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(RenderStateTest, RejectsOtherFiles)
+{
+    const auto path = std::filesystem::temp_directory_path() / "nfract_render_state_garbage.bin";
+    {
+        std::ofstream out{path};
+        out << "not a state file";
+    }
+    EXPECT_THROW(static_cast<void>(RenderState::load(path)), std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(static_cast<void>(RenderState::load(path)), std::runtime_error);
+}
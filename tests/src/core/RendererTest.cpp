@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "core/Image.hpp"
+#include "core/Renderer.hpp"
+#include "core/RenderNewton.hpp"
+#include "core/RootsTable.hpp"
+#include "../support/TestUtils.hpp"
+
+using nfract::Image;
+using nfract::RenderParams;
+using nfract::Renderer;
+
+namespace
+{
+    constexpr std::uint8_t padding_byte = 0xAB;
+
+    [[nodiscard]] RenderParams make_params()
+    {
+        // 37 pixels wide: not a multiple of the band height nor of the batch width
+        RenderParams p = nfract::test::make_params(4, 37, 35, 25);
+        p.ymin = -1.2f;
+        p.ymax = 1.2f;
+        return p;
+    }
+
+    /// Every form, and a perturbation render small enough for its reference orbits
+    [[nodiscard]] std::vector<RenderParams> every_form_and_perturbation()
+    {
+        std::vector<RenderParams> forms = nfract::test::every_form(make_params());
+        RenderParams perturbation = make_params();
+        perturbation.precision = nfract::Precision::PERTURBATION;
+        perturbation.width = 12;
+        perturbation.height = 10;
+        forms.push_back(perturbation);
+        return forms;
+    }
+
+    /// What the single-threaded free functions produce for p
+    [[nodiscard]] Image reference(const RenderParams& p)
+    {
+        const auto prepared = nfract::PreparedPolynomial::prepare(p);
+        Image img{p.width, p.height};
+#ifdef RUN_ON_CPU
+        nfract::render_newton_cpu(p, prepared.roots, img);
+#else
+        nfract::render_newton_ispc(p, prepared.roots, img);
+#endif
+        return img;
+    }
+
+    /// Renders p with a padded stride and checks the rows against the reference and the padding against padding_byte
+    void expect_renders_with_stride(Renderer& renderer, const RenderParams& p, const std::size_t padding)
+    {
+        const std::size_t row_bytes = static_cast<std::size_t>(p.width) * 4u;
+        const std::size_t stride = row_bytes + padding;
+        std::vector<std::uint8_t> buffer(stride * static_cast<std::size_t>(p.height), padding_byte);
+        renderer.render(p, buffer.data(), stride);
+
+        const Image expected = reference(p);
+        for (int y = 0; y < p.height; ++y)
+        {
+            const std::uint8_t* row = buffer.data() + static_cast<std::size_t>(y) * stride;
+            EXPECT_EQ(std::memcmp(row, expected.row(y).data(), row_bytes), 0) << "form " << static_cast<int>(p.form) << " row " << y;
+            for (std::size_t i = row_bytes; i < stride; ++i)
+            {
+                EXPECT_EQ(row[i], padding_byte) << "row " << y;
+            }
+        }
+    }
+}
+
+TEST(RendererTest, WritesEveryFormIntoStridedMemory)
+{
+    Renderer renderer{3};
+
+    for (const RenderParams& p : every_form_and_perturbation())
+    {
+        expect_renders_with_stride(renderer, p, 0);
+        expect_renders_with_stride(renderer, p, 20);
+        // Second time from the cache
+        expect_renders_with_stride(renderer, p, 20);
+    }
+}
+
+TEST(RendererTest, RendersRegionsInPlace)
+{
+    Renderer renderer{2};
+
+    for (const RenderParams& p : every_form_and_perturbation())
+    {
+        const Image expected = reference(p);
+        const nfract::PixelRect regions[] = {
+            {3, 2, 7, 5},
+            {0, 0, 1, 1},
+            {p.width - 9, p.height - 4, 9, 4},
+            nfract::PixelRect::frame(p),
+        };
+        for (const nfract::PixelRect& region : regions)
+        {
+            Image img{p.width, p.height};
+            std::ranges::fill(img.pixels(), padding_byte);
+            renderer.render(p, region, img);
+
+            for (int y = 0; y < p.height; ++y)
+            {
+                for (int x = 0; x < p.width; ++x)
+                {
+                    const bool inside = x >= region.x && x < region.x + region.width && y >= region.y && y < region.y + region.height;
+                    const std::uint8_t* pixel = img.pixel(x, y);
+                    if (inside)
+                    {
+                        ASSERT_EQ(std::memcmp(pixel, expected.pixel(x, y), 4), 0) << "form " << static_cast<int>(p.form) << " pixel " << x << "," << y;
+                    }
+                    else
+                    {
+                        ASSERT_EQ(pixel[0], padding_byte) << "pixel " << x << "," << y << " is outside the region";
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(RendererTest, EqualizedPipelineMatchesSingleThreadedRender)
+{
+    Renderer renderer{3};
+    RenderParams p = make_params();
+    p.colorMode = nfract::ColorMode::EQUALIZED;
+    p.width = 61;
+    p.height = 47;
+    expect_renders_with_stride(renderer, p, 12);
+
+    // Regions are ranked against the whole frame, so they still piece together
+    const Image expected = reference(p);
+    const nfract::PixelRect region{5, 9, 30, 21};
+    Image img{p.width, p.height};
+    renderer.render(p, region, img);
+    for (int y = region.y; y < region.y + region.height; ++y)
+    {
+        EXPECT_EQ(0, std::memcmp(img.pixel(region.x, y), expected.pixel(region.x, y), static_cast<std::size_t>(region.width) * 4u)) << "row " << y;
+    }
+}
+
+TEST(RendererTest, IgnoresRegionsOutsideTheFrame)
+{
+    Renderer renderer{1};
+    const RenderParams p = make_params();
+    Image img{p.width, p.height};
+    for (const nfract::PixelRect& region : {nfract::PixelRect{0, 0, 0, 4}, nfract::PixelRect{-1, 0, 4, 4}, nfract::PixelRect{p.width - 3, 0, 4, 4}, nfract::PixelRect{0, p.height, 1, 1}})
+    {
+        renderer.render(p, region, img);
+    }
+    EXPECT_TRUE(std::ranges::all_of(img.pixels(), [](const auto v) { return v == 0; }));
+
+    std::vector<std::uint8_t> buffer(64, padding_byte);
+    renderer.render(p, nfract::PixelRect{2, 2, 4, 4}, nfract::ImageView{buffer.data(), 4, 4, 12});
+    EXPECT_TRUE(std::ranges::all_of(buffer, [](const auto v) { return v == padding_byte; }));
+}
+
+TEST(RendererTest, IgnoresStrideShorterThanARow)
+{
+    Renderer renderer{1};
+    const RenderParams p = make_params();
+    std::vector<std::uint8_t> buffer(static_cast<std::size_t>(p.width * p.height) * 4u, padding_byte);
+    renderer.render(p, buffer.data(), static_cast<std::size_t>(p.width) * 4u - 4u);
+    EXPECT_TRUE(std::ranges::all_of(buffer, [](const auto v) { return v == padding_byte; }));
+
+    Image wrong{p.width + 1, p.height};
+    renderer.render(p, wrong);
+    EXPECT_TRUE(std::ranges::all_of(wrong.pixels(), [](const auto v) { return v == 0; }));
+}
+
+TEST(RendererTest, RendersConcurrentlyFromSeveralThreads)
+{
+    Renderer renderer{2};
+
+    // More distinct polynomials than the cache holds, so threads also race on evictions
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&renderer, t]
+        {
+            for (int round = 0; round < 3; ++round)
+            {
+                for (int degree = 2 + t; degree <= 30; degree += 4)
+                {
+                    RenderParams p = make_params();
+                    p.degree = degree;
+                    Image img{p.width, p.height};
+                    renderer.render(p, img);
+                    const Image expected = reference(p);
+                    EXPECT_TRUE(std::ranges::equal(img.pixels(), expected.pixels())) << "degree " << degree;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST(RendererTest, AsyncRenderMatchesSynchronousRender)
+{
+    Renderer renderer{2};
+    const RenderParams p = make_params();
+    const std::size_t stride = static_cast<std::size_t>(p.width) * 4u + 8u;
+    std::vector<std::uint8_t> buffer(stride * static_cast<std::size_t>(p.height), padding_byte);
+
+    nfract::RenderTask task = renderer.render_async(p, buffer.data(), stride);
+    EXPECT_EQ(task.get(), nfract::RenderStatus::COMPLETED);
+    EXPECT_EQ(task.tiles_done(), task.tiles_total());
+    EXPECT_GT(task.tiles_total(), 0);
+    EXPECT_FLOAT_EQ(task.progress(), 1.0f);
+
+    const Image expected = reference(p);
+    for (int y = 0; y < p.height; ++y)
+    {
+        EXPECT_EQ(std::memcmp(buffer.data() + static_cast<std::size_t>(y) * stride, expected.row(y).data(), expected.row(y).size()), 0) << "row " << y;
+    }
+
+    nfract::RenderTask bad = renderer.render_async(p, buffer.data(), 4);
+    EXPECT_THROW(static_cast<void>(bad.get()), std::invalid_argument);
+}
+
+TEST(RendererTest, CancelledRenderStopsBetweenTiles)
+{
+    Renderer renderer{1};
+    RenderParams p = make_params();
+    p.width = 512;
+    p.height = 2048;
+    p.maxIter = 200;
+    p.degree = 9;
+    std::vector<std::uint8_t> buffer(static_cast<std::size_t>(p.width * p.height) * 4u);
+
+    nfract::RenderTask task = renderer.render_async(p, buffer.data(), static_cast<std::size_t>(p.width) * 4u);
+    while (task.tiles_done() == 0 && !task.ready())
+    {
+        std::this_thread::yield();
+    }
+    task.cancel();
+    EXPECT_EQ(task.get(), nfract::RenderStatus::CANCELLED);
+    EXPECT_LT(task.tiles_done(), task.tiles_total());
+    EXPECT_LT(task.progress(), 1.0f);
+
+    // Dropping a task cancels it; the renderer stays usable
+    {
+        nfract::RenderTask dropped = renderer.render_async(p, buffer.data(), static_cast<std::size_t>(p.width) * 4u);
+    }
+    const RenderParams small = make_params();
+    Image img{small.width, small.height};
+    renderer.render(small, img);
+    EXPECT_TRUE(std::ranges::equal(img.pixels(), reference(small).pixels()));
+}
+
+TEST(RendererTest, FindsExpressionRootsFromTheText)
+{
+    Renderer renderer{2};
+
+    const RenderParams expression = nfract::test::as_expression(make_params());
+    Image img{expression.width, expression.height};
+    renderer.render(expression, img);
+
+    // Same text with stale coefficients alongside it: the cached entry and a fresh prepare must both follow the text
+    RenderParams stale = expression;
+    stale.coefficients = {{1.0, 0.0}, {0.0, 0.0}, {-1.0, 0.0}};
+    Image cached{stale.width, stale.height};
+    renderer.render(stale, cached);
+    EXPECT_TRUE(std::ranges::equal(cached.pixels(), img.pixels()));
+    EXPECT_TRUE(std::ranges::equal(reference(stale).pixels(), img.pixels()));
+}
+
+TEST(RendererTest, KeysFamiliesOnBothCoefficientLists)
+{
+    Renderer renderer{2};
+
+    const RenderParams family = nfract::test::as_family(make_params());
+    Image first{family.width, family.height};
+    renderer.render(family, first);
+
+    RenderParams other = family;
+    other.parameterCoefficients = {{0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {-1.0, 0.0}};
+    Image second{other.width, other.height};
+    renderer.render(other, second);
+    EXPECT_TRUE(std::ranges::equal(second.pixels(), reference(other).pixels()));
+    EXPECT_FALSE(std::ranges::equal(second.pixels(), first.pixels()));
+}
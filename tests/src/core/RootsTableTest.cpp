@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <complex>
 #include <stdexcept>
+#include <vector>
 
+#include "core/Polynomial.hpp"
 #include "core/RootsTable.hpp"
 
 using nfract::RootsTable;
@@ -54,3 +58,40 @@ TEST(RootsTableTest, RealAndImagSpansExposeRoots)
     EXPECT_NEAR(real[2], half, 1e-5f);
     EXPECT_NEAR(imag[2], -sqrt3_over_2, 1e-5f);
 }
+
+TEST(RootsTableTest, SolvesArbitraryPolynomial)
+{
+    // (z - 2)(z + 1)(z - i) = z^3 - (1 + i) z^2 + (-2 + i) z + 2i
+    const std::vector<std::complex<double>> coefficients{{1.0, 0.0}, {-1.0, -1.0}, {-2.0, 1.0}, {0.0, 2.0}};
+    const RootsTable table{nfract::Polynomial{coefficients}};
+
+    ASSERT_EQ(table.size(), 3);
+    for (const std::complex<float> expected : {std::complex{2.0f, 0.0f}, std::complex{-1.0f, 0.0f}, std::complex{0.0f, 1.0f}})
+    {
+        bool found = false;
+        for (int k = 0; k < table.size(); ++k)
+        {
+            found = found || std::abs(table.root(k) - expected) < 1e-5f;
+        }
+        EXPECT_TRUE(found) << "Missing root " << expected;
+    }
+}
+
+TEST(RootsTableTest, SolvesHighDegreePolynomial)
+{
+    // z^300 - 1 through the general solver must reproduce the closed form roots of unity
+    constexpr int degree = 300;
+    const RootsTable solved{nfract::Polynomial::unity(degree)};
+    const RootsTable exact{degree};
+
+    ASSERT_EQ(solved.size(), degree);
+    for (int k = 0; k < exact.size(); ++k)
+    {
+        float nearest = 1.0f;
+        for (int j = 0; j < solved.size(); ++j)
+        {
+            nearest = std::min(nearest, std::abs(solved.root(j) - exact.root(k)));
+        }
+        EXPECT_LT(nearest, 1e-5f) << "Missing root " << exact.root(k);
+    }
+}
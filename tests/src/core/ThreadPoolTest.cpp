@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/ThreadPool.hpp"
+
+using nfract::ThreadPool;
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    ThreadPool pool{3};
+    EXPECT_EQ(pool.concurrency(), 4);
+
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallel_for(static_cast<int>(visits.size()), [&](const int i) { visits[static_cast<std::size_t>(i)].fetch_add(1); });
+    for (const auto& v : visits)
+    {
+        EXPECT_EQ(v.load(), 1);
+    }
+
+    int untouched = 0;
+    pool.parallel_for(0, [&](int) { ++untouched; });
+    EXPECT_EQ(untouched, 0);
+}
+
+TEST(ThreadPoolTest, NestedAndRepeatedLoopsComplete)
+{
+    ThreadPool pool{2};
+    std::atomic<int> total{0};
+    for (int round = 0; round < 50; ++round)
+    {
+        pool.parallel_for(8, [&](int)
+        {
+            pool.parallel_for(16, [&](int) { total.fetch_add(1); });
+        });
+    }
+    EXPECT_EQ(total.load(), 50 * 8 * 16);
+}
+
+TEST(ThreadPoolTest, SingleIndexRunsOnCaller)
+{
+    ThreadPool pool{2};
+    std::thread::id ran_on{};
+    pool.parallel_for(1, [&](int) { ran_on = std::this_thread::get_id(); });
+    EXPECT_EQ(ran_on, std::this_thread::get_id());
+}
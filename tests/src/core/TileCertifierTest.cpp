@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <vector>
+
+#include "core/IterationKernel.hpp"
+#include "core/Polynomial.hpp"
+#include "core/RootsTable.hpp"
+#include "core/TileCertifier.hpp"
+
+using nfract::Complex;
+using nfract::RootsTable;
+using nfract::TileCertificate;
+using nfract::TileCertifier;
+
+namespace
+{
+    const std::vector<std::complex<double>> cubic{1.0, 0.0, 0.0, -1.0};
+
+    /// Iterates one float pixel the way the Newton kernel of `f` does
+    template <typename Function>
+    void iterate(const Function& f, const RootsTable& roots, Complex z, const int maxIter, const float tolerance, int& iter, int& root)
+    {
+        const float tol2 = tolerance * tolerance;
+        for (iter = 0; iter < maxIter; ++iter)
+        {
+            nfract::Jet<1> fz;
+            Complex dz{};
+            if (!f.template evaluate<1>(z, tol2, fz) || !nfract::NewtonStep{}(fz, dz))
+            {
+                break;
+            }
+            z.re -= dz.re;
+            z.im -= dz.im;
+        }
+        float dist2{};
+        root = nfract::NearestRoot{roots}.nearest(z, dist2);
+        EXPECT_LT(dist2, tol2);
+    }
+}
+
+TEST(TileCertifierTest, CertifiedTilesHoldEveryPixelTrajectory)
+{
+    const RootsTable roots{3};
+    TileCertifier certifier{cubic, roots, 50, 1e-4f};
+
+    for (const std::complex<double> center : {std::complex<double>{1.3, 0.1}, {-0.55, 0.9}, {-0.6, -1.1}, {2.5, 2.0}})
+    {
+        const double radius = 0.02;
+        const TileCertificate certificate = certifier.certify(center, radius);
+        ASSERT_TRUE(certificate.certified) << center;
+        EXPECT_LE(certificate.firstIter, certificate.lastIter);
+
+        // Every pixel of a grid inside the disc stops within the certified range, at the certified root
+        for (int i = -4; i <= 4; ++i)
+        {
+            for (int j = -4; j <= 4; ++j)
+            {
+                const Complex z{static_cast<float>(center.real() + radius * 0.17 * i), static_cast<float>(center.imag() + radius * 0.17 * j)};
+                int iter = 0;
+                int root = 0;
+                iterate(nfract::AutoDiff{nfract::UnityFunction{3}}, roots, z, 50, 1e-4f, iter, root);
+                EXPECT_GE(iter, certificate.firstIter) << center;
+                EXPECT_LE(iter, certificate.lastIter) << center;
+                EXPECT_EQ(root, certificate.root) << center;
+            }
+        }
+    }
+}
+
+TEST(TileCertifierTest, RejectsTilesAcrossBasinsOrOverCriticalPoints)
+{
+    const RootsTable roots{3};
+    TileCertifier certifier{cubic, roots, 50, 1e-4f};
+
+    // f' vanishes at 0; -1 lies on the boundary shared by all three basins
+    EXPECT_FALSE(certifier.certify({0.0, 0.0}, 0.05).certified);
+    EXPECT_FALSE(certifier.certify({-1.0, 0.0}, 0.01).certified);
+    // Too few iterations for the tile to reach the tolerance
+    TileCertifier short_budget{cubic, roots, 2, 1e-4f};
+    EXPECT_FALSE(short_budget.certify({1.3, 0.1}, 0.02).certified);
+    // Unsupported degrees
+    TileCertifier constant{std::vector<std::complex<double>>{1.0}, roots, 50, 1e-4f};
+    EXPECT_FALSE(constant.certify({1.0, 0.0}, 0.01).certified);
+}
+
+TEST(TileCertifierTest, CertifiesTheNewtonStepTestOfScaledPolynomials)
+{
+    // 0.01 (z^3 - 1): |f| stays below the tolerance well before the pixels near a root, the Newton step does not
+    const std::vector<std::complex<double>> scaled{0.01, 0.0, 0.0, -0.01};
+    const nfract::Polynomial poly{scaled};
+    const RootsTable roots{3};
+    TileCertifier certifier{scaled, roots, 50, 1e-4f, TileCertifier::StopTest::NEWTON_STEP};
+
+    for (const std::complex<double> center : {std::complex<double>{1.3, 0.1}, {-0.55, 0.9}})
+    {
+        const double radius = 0.02;
+        const TileCertificate certificate = certifier.certify(center, radius);
+        ASSERT_TRUE(certificate.certified) << center;
+
+        for (int i = -4; i <= 4; ++i)
+        {
+            for (int j = -4; j <= 4; ++j)
+            {
+                const Complex z{static_cast<float>(center.real() + radius * 0.17 * i), static_cast<float>(center.imag() + radius * 0.17 * j)};
+                int iter = 0;
+                int root = 0;
+                iterate(nfract::HornerFunction{poly}, roots, z, 50, 1e-4f, iter, root);
+                EXPECT_GE(iter, certificate.firstIter) << center;
+                EXPECT_LE(iter, certificate.lastIter) << center;
+                EXPECT_EQ(root, certificate.root) << center;
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "core/Image.hpp"
+#include "core/RenderNewton.hpp"
+#include "core/Renderer.hpp"
+#include "core/ViewportCache.hpp"
+#include "../support/TestUtils.hpp"
+
+using nfract::Image;
+using nfract::RenderParams;
+using nfract::ViewportCache;
+using nfract::ViewportStats;
+
+namespace
+{
+    /// 129 x 65 pixels, 1/32 apart on both axes, so panned and zoomed grids land exactly on the old positions
+    [[nodiscard]] RenderParams make_params()
+    {
+        RenderParams p = nfract::test::make_params(5, 129, 65, 40);
+        p.xmin = -2.0f;
+        p.xmax = 2.0f;
+        return p;
+    }
+
+    [[nodiscard]] Image reference(const RenderParams& p)
+    {
+        Image img{p.width, p.height};
+        nfract::render_newton_cpu(p, nfract::PreparedPolynomial::prepare(p).roots, img);
+        return img;
+    }
+
+    [[nodiscard]] RenderParams panned(RenderParams p, const int columns, const int rows)
+    {
+        p.xmin += static_cast<float>(columns) / 32.0f;
+        p.xmax += static_cast<float>(columns) / 32.0f;
+        p.ymin += static_cast<float>(rows) / 32.0f;
+        p.ymax += static_cast<float>(rows) / 32.0f;
+        return p;
+    }
+}
+
+TEST(ViewportCacheTest, PanIteratesOnlyTheExposedStrips)
+{
+    nfract::Renderer renderer{2};
+
+    const RenderParams unity = make_params();
+    const RenderParams expression = nfract::test::as_expression(make_params());
+
+    for (const RenderParams* start : {&unity, &expression})
+    {
+        ViewportCache cache{renderer};
+        Image img{start->width, start->height};
+
+        const ViewportStats first = cache.render(*start, img);
+        EXPECT_EQ(first.reused, 0);
+        EXPECT_EQ(first.computed, start->width * start->height);
+        EXPECT_TRUE(std::ranges::equal(img.pixels(), reference(*start).pixels()));
+
+        const RenderParams right = panned(*start, 8, 4);
+        const ViewportStats second = cache.render(right, img);
+        EXPECT_EQ(second.reused, (start->width - 8) * (start->height - 4));
+        EXPECT_EQ(second.computed, start->width * start->height - second.reused);
+        EXPECT_TRUE(std::ranges::equal(img.pixels(), reference(right).pixels())) << "form " << static_cast<int>(start->form);
+
+        const RenderParams back = panned(right, -3, -1);
+        const ViewportStats third = cache.render(back, img);
+        EXPECT_EQ(third.reused, (start->width - 3) * (start->height - 1));
+        EXPECT_TRUE(std::ranges::equal(img.pixels(), reference(back).pixels())) << "form " << static_cast<int>(start->form);
+    }
+}
+
+TEST(ViewportCacheTest, ZoomReusesEveryOtherSample)
+{
+    nfract::Renderer renderer{2};
+    ViewportCache cache{renderer};
+    const RenderParams wide = make_params();
+    Image img{wide.width, wide.height};
+    static_cast<void>(cache.render(wide, img));
+
+    // Half the span about the centre: even columns and rows sit on old pixels
+    RenderParams zoomed = wide;
+    zoomed.xmin = -1.0f;
+    zoomed.xmax = 1.0f;
+    zoomed.ymin = -0.5f;
+    zoomed.ymax = 0.5f;
+    const ViewportStats in = cache.render(zoomed, img);
+    EXPECT_EQ(in.reused, 65 * 33);
+    EXPECT_TRUE(std::ranges::equal(img.pixels(), reference(zoomed).pixels()));
+
+    // And back out: the middle quarter of the frame is known
+    const ViewportStats out = cache.render(wide, img);
+    EXPECT_EQ(out.reused, 65 * 33);
+    EXPECT_TRUE(std::ranges::equal(img.pixels(), reference(wide).pixels()));
+}
+
+TEST(ViewportCacheTest, ReusesSamplesOnlyForTheSameIteration)
+{
+    nfract::Renderer renderer{1};
+    ViewportCache cache{renderer};
+    RenderParams p = make_params();
+    Image img{p.width, p.height};
+    static_cast<void>(cache.render(p, img));
+
+    // The palette is applied after the field, so a new one costs no iterations
+    p.colorMode = nfract::ColorMode::NEON;
+    const ViewportStats recoloured = cache.render(p, img);
+    EXPECT_EQ(recoloured.computed, 0);
+    EXPECT_TRUE(std::ranges::equal(img.pixels(), reference(p).pixels()));
+
+    p.maxIter = 60;
+    EXPECT_EQ(cache.render(p, img).reused, 0);
+    EXPECT_TRUE(std::ranges::equal(img.pixels(), reference(p).pixels()));
+
+    cache.clear();
+    EXPECT_EQ(cache.render(p, img).reused, 0);
+
+    // A view that falls between the old pixels reuses nothing
+    p.xmin += 1.0f / 64.0f;
+    p.xmax += 1.0f / 64.0f;
+    EXPECT_EQ(cache.render(p, img).reused, 0);
+}
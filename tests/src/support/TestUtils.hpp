@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <complex>
 #include <filesystem>
 #include <initializer_list>
 #include <random>
@@ -11,8 +12,80 @@
 #include <utility>
 #include <vector>
 
+#include "core/RenderParams.hpp"
+
 namespace nfract::test
 {
+    /// A width x height render of z^degree - 1 over [-1.5, 1.5] x [-1, 1] with a tolerance of 1e-4, the view the
+    /// render tests start from. Params is RenderParams or a type extending it, such as Arguments.
+    template <typename Params = RenderParams>
+    [[nodiscard]] Params make_params(const int degree, const int width, const int height, const int maxIter)
+    {
+        Params p;
+        p.degree = degree;
+        p.width = width;
+        p.height = height;
+        p.maxIter = maxIter;
+        p.xmin = -1.5f;
+        p.xmax = 1.5f;
+        p.ymin = -1.0f;
+        p.ymax = 1.0f;
+        p.tolerance = 1e-4f;
+        return p;
+    }
+
+    /// The view of p with z^4 + (-2 + i) z^2 + 0.5i z + 1 given by its coefficients
+    template <typename Params>
+    [[nodiscard]] Params as_coefficients(Params p)
+    {
+        p.form = PolynomialForm::COEFFICIENTS;
+        p.coefficients = {{1.0, 0.0}, {0.0, 0.0}, {-2.0, 1.0}, {0.0, 0.5}, {1.0, 0.0}};
+        return p;
+    }
+
+    /// The view of p with the roots 1 and -0.5 +- 0.8i, iterated with Halley's method
+    template <typename Params>
+    [[nodiscard]] Params as_roots(Params p)
+    {
+        p.form = PolynomialForm::ROOTS;
+        p.roots = {{1.0, 0.0}, {-0.5, 0.8}, {-0.5, -0.8}};
+        p.method = Method::HALLEY;
+        return p;
+    }
+
+    /// as_coefficients() typed as an expression, with the coefficients the parser fills in alongside it
+    template <typename Params>
+    [[nodiscard]] Params as_expression(Params p)
+    {
+        p = as_coefficients(p);
+        p.form = PolynomialForm::EXPRESSION;
+        p.expression = "z^4 + (-2 + i) z^2 + 0.5i z + 1";
+        return p;
+    }
+
+    /// The view of p as the parameter plane of z^3 - z + a (z - 1)
+    template <typename Params>
+    [[nodiscard]] Params as_family(Params p)
+    {
+        p.form = PolynomialForm::FAMILY;
+        p.coefficients = {{1.0, 0.0}, {0.0, 0.0}, {-1.0, 0.0}, {0.0, 0.0}};
+        p.parameterCoefficients = {{0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}, {-1.0, 0.0}};
+        return p;
+    }
+
+    template <typename Params>
+    [[nodiscard]] Params as_double_double(Params p)
+    {
+        p.precision = Precision::DOUBLE_DOUBLE;
+        return p;
+    }
+
+    /// p as is and in each of the forms above: every kernel of the single precision and double-double renderers
+    [[nodiscard]] inline std::vector<RenderParams> every_form(const RenderParams& p)
+    {
+        return {p, as_coefficients(p), as_roots(p), as_expression(p), as_family(p), as_double_double(p)};
+    }
+
     class ArgvBuilder
     {
     public: